@@ -5,7 +5,7 @@ from .variable_type import SPIN, BINARY, Vartype, cast_var_type
 
 
 from .sampler import Response
-from .sampler import SASampler, SQASampler, CSQASampler
+from .sampler import SASampler, SQASampler, CSQASampler, TabuSampler
 from .sampler import GPUChimeraSQASampler, GPUChimeraSASampler, CMOSAnnealer
 from .model import BinaryQuadraticModel, KingGraph, ChimeraModel
 from .utils import solver_benchmark, convert_response
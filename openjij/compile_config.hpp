@@ -35,6 +35,9 @@ namespace openjij {
 
     /**********************************************************
      default floating point precision on CPU (default: double)
+     classes of this precision are registered without suffix (e.g. graph.Dense).
+     float is also registered with suffix "Float32" (e.g. graph.DenseFloat32),
+     which can be selected at runtime.
      **********************************************************/
     using FloatType = double;
     //using FloatType = float;
@@ -44,6 +47,9 @@ namespace openjij {
     /**********************************************************
      default random number engine on CPU (default: xorshift)
      you may use mersenne twister or your own random number generator.
+     utility.Xorshift, utility.MT19937, utility.MT19937_64, utility.Philox4x32
+     and utility.Xoshiro256StarStar are also registered and can be passed to
+     Algorithm_*_run at runtime.
      **********************************************************/
     using RandomEngine = utility::Xorshift;
     //using RandomEngine = std::mt19937;
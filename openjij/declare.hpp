@@ -15,17 +15,26 @@
 #ifndef OPENJIJ_DECLARE_HPP__
 #define OPENJIJ_DECLARE_HPP__
 
+#include <limits>
+#include <random>
+#include <sstream>
+
 #include <graph/all.hpp>
 #include <system/all.hpp>
 #include <updater/all.hpp>
 #include <algorithm/all.hpp>
 #include <result/all.hpp>
+#include <utility/beta_range.hpp>
+#include <utility/checkpoint.hpp>
+#include <utility/schedule_generator.hpp>
 
 #include <pybind11_json/pybind11_json.hpp>
 #include <nlohmann/json.hpp>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 
 namespace py = pybind11;
@@ -159,6 +168,24 @@ inline void declare_Chimera(py::module& m, const std::string& suffix){
 
 //system
 
+//Observables
+template<typename FloatType>
+inline void declare_Observables(py::module &m, const std::string& suffix){
+    using Observables = system::Observables<FloatType>;
+    auto str = std::string("Observables") + suffix;
+    py::class_<Observables>(m, str.c_str())
+        .def_readonly("energy", &Observables::energy)
+        .def_readonly("magnetization", &Observables::magnetization)
+        .def_readonly("best_energy", &Observables::best_energy)
+        .def_readonly("num_accepted", &Observables::num_accepted)
+        .def_readonly("num_rejected", &Observables::num_rejected)
+        .def("acceptance_ratio", &Observables::acceptance_ratio)
+        .def("__repr__", [](const Observables& self){
+                return "Observables(energy=" + std::to_string(self.energy) + ", magnetization=" + std::to_string(self.magnetization)
+                + ", best_energy=" + std::to_string(self.best_energy) + ", acceptance_ratio=" + std::to_string(self.acceptance_ratio()) + ")";
+                });
+}
+
 //ClassicalIsing
 template<typename GraphType>
 inline void declare_ClassicalIsing(py::module &m, const std::string& gtype_str){
@@ -169,9 +196,20 @@ inline void declare_ClassicalIsing(py::module &m, const std::string& gtype_str){
     py::class_<ClassicalIsing>(m, str.c_str())
         .def(py::init<const graph::Spins&, const GraphType&>(), "init_spin"_a, "init_interaction"_a)
         .def("reset_spins", [](ClassicalIsing& self, const graph::Spins& init_spin){self.reset_spins(init_spin);},"init_spin"_a)
-        .def_readwrite("spin", &ClassicalIsing::spin)
+        .def_property("spin",
+                [](const ClassicalIsing& self) -> const typename ClassicalIsing::VectorXx& {return self.spin;},
+                [](ClassicalIsing& self, const typename ClassicalIsing::VectorXx& spin){
+                    self.spin = spin;
+                    self.reset_observables(); //keep observables consistent
+                })
         .def_readonly("interaction", &ClassicalIsing::interaction)
-        .def_readonly("num_spins", &ClassicalIsing::num_spins);
+        .def_readonly("num_spins", &ClassicalIsing::num_spins)
+        .def_readonly("observables", &ClassicalIsing::observables)
+        .def("reset_observables", &ClassicalIsing::reset_observables)
+        .def_property("track_best_spin",
+                [](const ClassicalIsing& self){return self.track_best_spin;},
+                [](ClassicalIsing& self, bool enable){self.set_track_best_spin(enable);})
+        .def_property_readonly("best_spin", &ClassicalIsing::best_spin);
 
     //make_classical_ising
     auto mkci_str = std::string("make_classical_ising");
@@ -194,10 +232,18 @@ inline void declare_TransverseIsing(py::module &m, const std::string& gtype_str)
         .def(py::init<const graph::Spins&, const GraphType&, FloatType, size_t>(), "init_classical_spins"_a, "init_interaction"_a, "gamma"_a, "num_trotter_slices"_a)
         .def("reset_spins", [](TransverseIsing& self, const system::TrotterSpins& init_trotter_spins){self.reset_spins(init_trotter_spins);},"init_trotter_spins"_a)
         .def("reset_spins", [](TransverseIsing& self, const graph::Spins& classical_spins){self.reset_spins(classical_spins);},"classical_spins"_a)
-        .def_readwrite("trotter_spins", &TransverseIsing::trotter_spins)
+        .def_property("trotter_spins",
+                [](const TransverseIsing& self) -> const typename TransverseIsing::TrotterMatrix& {return self.trotter_spins;},
+                [](TransverseIsing& self, const typename TransverseIsing::TrotterMatrix& trotter_spins){
+                    self.trotter_spins = trotter_spins;
+                    self.reset_local_field(); //keep local fields consistent
+                })
+        .def_readonly("local_field", &TransverseIsing::local_field)
+        .def_readonly("slice_energy", &TransverseIsing::slice_energy)
         .def_readonly("interaction", &TransverseIsing::interaction)
         .def_readonly("num_classical_spins", &TransverseIsing::num_classical_spins)
-        .def_readwrite("gamma", &TransverseIsing::gamma);
+        .def_readwrite("gamma", &TransverseIsing::gamma)
+        .def_readwrite("worldline_flip_ratio", &TransverseIsing::worldline_flip_ratio);
 
     //make_transverse_ising
     auto mkci_str = std::string("make_transverse_ising");
@@ -210,6 +256,48 @@ inline void declare_TransverseIsing(py::module &m, const std::string& gtype_str)
             }, "classical_spins"_a, "init_interaction"_a, "gamma"_a, "num_trotter_slices"_a);
 }
 
+//PackedTransverseIsing
+template<typename GraphType>
+inline void declare_PackedTransverseIsing(py::module &m, const std::string& gtype_str){
+    using PackedTransverseIsing = system::PackedTransverseIsing<GraphType>;
+    using FloatType = typename GraphType::value_type;
+    using TrotterMatrix = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+
+    auto str = std::string("PackedTransverseIsing")+gtype_str;
+    py::class_<PackedTransverseIsing>(m, str.c_str())
+        .def(py::init<const system::TrotterSpins&, const GraphType&, FloatType>(), "init_spin"_a, "init_interaction"_a, "gamma"_a)
+        .def(py::init<const graph::Spins&, const GraphType&, FloatType, size_t>(), "init_classical_spins"_a, "init_interaction"_a, "gamma"_a, "num_trotter_slices"_a)
+        .def("reset_spins", [](PackedTransverseIsing& self, const system::TrotterSpins& init_trotter_spins){self.reset_spins(init_trotter_spins);},"init_trotter_spins"_a)
+        .def("reset_spins", [](PackedTransverseIsing& self, const graph::Spins& classical_spins){self.reset_spins(classical_spins);},"classical_spins"_a)
+        .def("get_trotter_spins", &PackedTransverseIsing::get_trotter_spins)
+        .def_property_readonly("trotter_spins", [](const PackedTransverseIsing& self){
+                //same layout as TransverseIsing::trotter_spins (dummy spin in the last row)
+                TrotterMatrix trotter_spins(self.num_classical_spins+1, self.num_trotter_slices);
+                for(std::size_t t=0; t<self.num_trotter_slices; t++){
+                    for(std::size_t i=0; i<self.num_classical_spins; i++){
+                        trotter_spins(i, t) = self.spin(i, t);
+                    }
+                    trotter_spins(self.num_classical_spins, t) = 1;
+                }
+                return trotter_spins;
+                })
+        .def("num_kinks", &PackedTransverseIsing::num_kinks, "index"_a)
+        .def_readonly("interaction", &PackedTransverseIsing::interaction)
+        .def_readonly("num_classical_spins", &PackedTransverseIsing::num_classical_spins)
+        .def_readonly("num_trotter_slices", &PackedTransverseIsing::num_trotter_slices)
+        .def_readwrite("gamma", &PackedTransverseIsing::gamma);
+
+    //make_packed_transverse_ising
+    auto mkci_str = std::string("make_packed_transverse_ising");
+    m.def(mkci_str.c_str(), [](const system::TrotterSpins& init_trotter_spins, const GraphType& init_interaction, double gamma){
+            return system::make_packed_transverse_ising(init_trotter_spins, init_interaction, gamma);
+            }, "init_trotter_spins"_a, "init_interaction"_a, "gamma"_a);
+
+    m.def(mkci_str.c_str(), [](const graph::Spins& classical_spins, const GraphType& init_interaction, double gamma, std::size_t num_trotter_slices){
+            return system::make_packed_transverse_ising(classical_spins, init_interaction, gamma, num_trotter_slices);
+            }, "classical_spins"_a, "init_interaction"_a, "gamma"_a, "num_trotter_slices"_a);
+}
+
 //Continuous Time Transverse Ising
 template<typename GraphType>
 inline void declare_ContinuousTimeIsing(py::module &m, const std::string& gtype_str){
@@ -224,7 +312,15 @@ inline void declare_ContinuousTimeIsing(py::module &m, const std::string& gtype_
         .def(py::init<const graph::Spins&, const GraphType&, FloatType>(), "init_spins"_a, "init_interaction"_a, "gamma"_a)
         .def("reset_spins", [](TransverseIsing& self, const SpinConfiguration& init_spin_config){self.reset_spins(init_spin_config);},"init_spin_config"_a)
         .def("reset_spins", [](TransverseIsing& self, const graph::Spins& classical_spins){self.reset_spins(classical_spins);},"classical_spins"_a)
-        .def_readwrite("spin_config", &TransverseIsing::spin_config)
+        .def_property("spin_config",
+                [](const TransverseIsing& self){return self.get_spin_config();},
+                [](TransverseIsing& self, const SpinConfiguration& spin_config){
+                    //the auxiliary timeline is included
+                    if(spin_config.size() != self.num_spins){
+                        throw std::invalid_argument("the number of timelines must be num_spins");
+                    }
+                    self.spin_config.assign(spin_config);
+                })
         .def_readonly("interaction", &TransverseIsing::interaction)
         .def_readonly("num_spins", &TransverseIsing::num_spins)
         .def_readonly("gamma", &TransverseIsing::gamma);
@@ -282,49 +378,432 @@ template<typename FloatType,
 
 
 //Algorithm
+//Algorithm with schedule generator (the schedules are generated on the fly)
+template<template<typename> class Updater, typename System, typename RandomNumberEngine, typename Curve>
+inline void declare_Algorithm_run_with_schedule_generator(py::module &m, const std::string& str, const std::string& tb_str){
+    using SystemType = typename system::get_system_type<System>::type;
+    using Generator = utility::ScheduleGenerator<SystemType, Curve>;
+    using Callback = std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>;
+
+    auto run = [](System& system, RandomNumberEngine& rng, const Generator& schedule_generator, const Callback& callback){
+        if(callback){
+            algorithm::Algorithm<Updater>::run(system, rng, schedule_generator,
+                    [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());});
+        }
+        else{
+            algorithm::Algorithm<Updater>::run(system, rng, schedule_generator);
+        }
+    };
+
+    //with seed
+    m.def(str.c_str(), [run](System& system, std::size_t seed, const Generator& schedule_generator, const Callback& callback){
+            RandomNumberEngine rng(seed);
+            run(system, rng, schedule_generator, callback);
+            }, "system"_a, "seed"_a, "schedule_generator"_a, "callback"_a = nullptr);
+
+    //without seed
+    m.def(str.c_str(), [run](System& system, const Generator& schedule_generator, const Callback& callback){
+            RandomNumberEngine rng(std::random_device{}());
+            run(system, rng, schedule_generator, callback);
+            }, "system"_a, "schedule_generator"_a, "callback"_a = nullptr);
+
+    //within wall-clock time budget, the generator gives the shape of the schedule
+    m.def(tb_str.c_str(), [](System& system, std::size_t seed, const Generator& schedule_generator, double time_budget){
+            RandomNumberEngine rng(seed);
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule_generator.materialize(), std::chrono::duration<double>(time_budget));
+            }, "system"_a, "seed"_a, "schedule_generator"_a, "time_budget"_a);
+
+    m.def(tb_str.c_str(), [](System& system, const Generator& schedule_generator, double time_budget){
+            RandomNumberEngine rng(std::random_device{}());
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule_generator.materialize(), std::chrono::duration<double>(time_budget));
+            }, "system"_a, "schedule_generator"_a, "time_budget"_a);
+}
+
 template<template<typename> class Updater, typename System, typename RandomNumberEngine>
 inline void declare_Algorithm_run(py::module &m, const std::string& updater_str){
     auto str = std::string("Algorithm_")+updater_str+std::string("_run");
     using SystemType = typename system::get_system_type<System>::type;
     //with seed
     m.def(str.c_str(), [](System& system, std::size_t seed, const utility::ScheduleList<SystemType>& schedule_list,
-                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback){
-            using Callback = std::function<void(const System&, const utility::UpdaterParameter<SystemType>&)>;
+                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback,
+                std::size_t callback_interval){
             RandomNumberEngine rng(seed);
-            algorithm::Algorithm<Updater>::run(system, rng, schedule_list,
-                    callback ? [=](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());} : Callback(nullptr));
-            }, "system"_a, "seed"_a, "schedule_list"_a, "callback"_a = nullptr);
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_list,
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());}, callback_interval);
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_list);
+            }
+            }, "system"_a, "seed"_a, "schedule_list"_a, "callback"_a = nullptr, "callback_interval"_a = 1);
 
     //without seed
     m.def(str.c_str(), [](System& system, const utility::ScheduleList<SystemType>& schedule_list,
-                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback){
-            using Callback = std::function<void(const System&, const utility::UpdaterParameter<SystemType>&)>;
+                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback,
+                std::size_t callback_interval){
             RandomNumberEngine rng(std::random_device{}());
-            algorithm::Algorithm<Updater>::run(system, rng, schedule_list,
-                    callback ? [=](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());} : Callback(nullptr));
-            }, "system"_a, "schedule_list"_a, "callback"_a = nullptr);
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_list,
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());}, callback_interval);
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_list);
+            }
+            }, "system"_a, "schedule_list"_a, "callback"_a = nullptr, "callback_interval"_a = 1);
 
     //schedule_list can be a list of tuples
     using TupleList = std::vector<std::pair<typename utility::UpdaterParameter<SystemType>::Tuple, std::size_t>>;
     
     //with seed
     m.def(str.c_str(), [](System& system, std::size_t seed, const TupleList& tuplelist,
-                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback){
-            using Callback = std::function<void(const System&, const utility::UpdaterParameter<SystemType>&)>;
+                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback,
+                std::size_t callback_interval){
             RandomNumberEngine rng(seed);
-            algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist),
-                    callback ? [=](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());} : Callback(nullptr));
-            }, "system"_a, "seed"_a, "tuplelist"_a, "callback"_a = nullptr);
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist),
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());}, callback_interval);
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist));
+            }
+            }, "system"_a, "seed"_a, "tuplelist"_a, "callback"_a = nullptr, "callback_interval"_a = 1);
 
     //without seed
     m.def(str.c_str(), [](System& system, const TupleList& tuplelist,
+                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback,
+                std::size_t callback_interval){
+            RandomNumberEngine rng(std::random_device{}());
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist),
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());}, callback_interval);
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist));
+            }
+            }, "system"_a, "tuplelist"_a, "callback"_a = nullptr, "callback_interval"_a = 1);
+
+    //within wall-clock time budget (in seconds), schedule_list gives the shape of the schedule
+    auto tb_str = std::string("Algorithm_")+updater_str+std::string("_run_with_time_budget");
+
+    //with seed
+    m.def(tb_str.c_str(), [](System& system, std::size_t seed, const utility::ScheduleList<SystemType>& schedule_list, double time_budget){
+            RandomNumberEngine rng(seed);
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule_list, std::chrono::duration<double>(time_budget));
+            }, "system"_a, "seed"_a, "schedule_list"_a, "time_budget"_a);
+
+    //without seed
+    m.def(tb_str.c_str(), [](System& system, const utility::ScheduleList<SystemType>& schedule_list, double time_budget){
+            RandomNumberEngine rng(std::random_device{}());
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule_list, std::chrono::duration<double>(time_budget));
+            }, "system"_a, "schedule_list"_a, "time_budget"_a);
+
+    //schedule_list can be a schedule generator
+    ::declare_Algorithm_run_with_schedule_generator<Updater, System, RandomNumberEngine, utility::LinearCurve>(m, str, tb_str);
+    ::declare_Algorithm_run_with_schedule_generator<Updater, System, RandomNumberEngine, utility::GeometricCurve>(m, str, tb_str);
+    ::declare_Algorithm_run_with_schedule_generator<Updater, System, RandomNumberEngine, utility::PowerCurve>(m, str, tb_str);
+    ::declare_Algorithm_run_with_schedule_generator<Updater, System, RandomNumberEngine, utility::PiecewiseLinearCurve>(m, str, tb_str);
+}
+
+//Algorithm with random number engine object and schedule generator
+template<template<typename> class Updater, typename System, typename RandomNumberEngine, typename Curve>
+inline void declare_Algorithm_run_with_engine_and_schedule_generator(py::module &m, const std::string& str){
+    using SystemType = typename system::get_system_type<System>::type;
+    using Generator = utility::ScheduleGenerator<SystemType, Curve>;
+
+    m.def(str.c_str(), [](System& system, RandomNumberEngine& rng, const Generator& schedule_generator,
                 const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback){
-            using Callback = std::function<void(const System&, const utility::UpdaterParameter<SystemType>&)>;
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_generator,
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());});
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_generator);
+            }
+            }, "system"_a, "random_number_engine"_a, "schedule_generator"_a, "callback"_a = nullptr);
+}
+
+//Algorithm with random number engine object (the engine is chosen at runtime by its type)
+template<template<typename> class Updater, typename System, typename RandomNumberEngine>
+inline void declare_Algorithm_run_with_engine(py::module &m, const std::string& updater_str){
+    auto str = std::string("Algorithm_")+updater_str+std::string("_run");
+    using SystemType = typename system::get_system_type<System>::type;
+
+    m.def(str.c_str(), [](System& system, RandomNumberEngine& rng, const utility::ScheduleList<SystemType>& schedule_list,
+                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback,
+                std::size_t callback_interval){
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_list,
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());}, callback_interval);
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, schedule_list);
+            }
+            }, "system"_a, "random_number_engine"_a, "schedule_list"_a, "callback"_a = nullptr, "callback_interval"_a = 1);
+
+    //schedule_list can be a list of tuples
+    using TupleList = std::vector<std::pair<typename utility::UpdaterParameter<SystemType>::Tuple, std::size_t>>;
+    m.def(str.c_str(), [](System& system, RandomNumberEngine& rng, const TupleList& tuplelist,
+                const std::function<void(const System&, const typename utility::UpdaterParameter<SystemType>::Tuple&)>& callback,
+                std::size_t callback_interval){
+            if(callback){
+                algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist),
+                        [&](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());}, callback_interval);
+            }
+            else{
+                algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist));
+            }
+            }, "system"_a, "random_number_engine"_a, "tuplelist"_a, "callback"_a = nullptr, "callback_interval"_a = 1);
+
+    //schedule_list can be a schedule generator
+    ::declare_Algorithm_run_with_engine_and_schedule_generator<Updater, System, RandomNumberEngine, utility::LinearCurve>(m, str);
+    ::declare_Algorithm_run_with_engine_and_schedule_generator<Updater, System, RandomNumberEngine, utility::GeometricCurve>(m, str);
+    ::declare_Algorithm_run_with_engine_and_schedule_generator<Updater, System, RandomNumberEngine, utility::PowerCurve>(m, str);
+    ::declare_Algorithm_run_with_engine_and_schedule_generator<Updater, System, RandomNumberEngine, utility::PiecewiseLinearCurve>(m, str);
+}
+
+template<template<typename> class Updater, typename System>
+inline void declare_Algorithm_run_with_engines(py::module &m, const std::string& updater_str){
+    ::declare_Algorithm_run_with_engine<Updater, System, utility::Xorshift>(m, updater_str);
+    ::declare_Algorithm_run_with_engine<Updater, System, std::mt19937>(m, updater_str);
+    ::declare_Algorithm_run_with_engine<Updater, System, std::mt19937_64>(m, updater_str);
+    ::declare_Algorithm_run_with_engine<Updater, System, utility::Philox4x32>(m, updater_str);
+    ::declare_Algorithm_run_with_engine<Updater, System, utility::Xoshiro256StarStar>(m, updater_str);
+}
+
+//independent replicas in parallel (replica i uses stream i of Philox4x32)
+template<template<typename> class Updater, typename System>
+inline void declare_Algorithm_run_replicas(py::module &m, const std::string& updater_str){
+    auto str = std::string("Algorithm_")+updater_str+std::string("_run_replicas");
+    using SystemType = typename system::get_system_type<System>::type;
+
+    //the replicas are copied from the list and the updated ones are returned
+    m.def(str.c_str(), [](std::vector<System> systems, std::uint64_t seed, const utility::ScheduleList<SystemType>& schedule_list){
+            algorithm::Algorithm<Updater>::run_replicas(systems, seed, schedule_list);
+            return systems;
+            }, "systems"_a, "seed"_a, "schedule_list"_a);
+
+    //replica i uses the master engine advanced by i jumps
+    m.def(str.c_str(), [](std::vector<System> systems, const utility::Xoshiro256StarStar& rng, const utility::ScheduleList<SystemType>& schedule_list){
+            algorithm::Algorithm<Updater>::run_replicas(systems, rng, schedule_list);
+            return systems;
+            }, "systems"_a, "random_number_engine"_a, "schedule_list"_a);
+}
+
+//Algorithm with history of observables (for the systems which have observables)
+template<template<typename> class Updater, typename System, typename RandomNumberEngine>
+inline void declare_Algorithm_run_with_history(py::module &m, const std::string& updater_str){
+    auto str = std::string("Algorithm_")+updater_str+std::string("_run_with_history");
+    using SystemType = typename system::get_system_type<System>::type;
+    using FloatType = std::remove_cv_t<decltype(std::declval<System&>().observables.energy)>;
+    using History = system::ObservablesHistory<FloatType>;
+
+    //convert history into numpy arrays
+    auto to_dict = [](const History& history){
+        auto to_array = [](const std::vector<FloatType>& v){ return py::array_t<FloatType>(v.size(), v.data()); };
+        return py::dict("energy"_a=to_array(history.energy), "magnetization"_a=to_array(history.magnetization),
+                "best_energy"_a=to_array(history.best_energy), "acceptance_ratio"_a=to_array(history.acceptance_ratio));
+    };
+
+    //with seed
+    m.def(str.c_str(), [to_dict](System& system, std::size_t seed, const utility::ScheduleList<SystemType>& schedule_list, std::size_t interval){
+            RandomNumberEngine rng(seed);
+            History history;
+            algorithm::Algorithm<Updater>::run(system, rng, schedule_list, history, interval);
+            return to_dict(history);
+            }, "system"_a, "seed"_a, "schedule_list"_a, "interval"_a = algorithm::Algorithm<Updater>::once_per_schedule);
+
+    //without seed
+    m.def(str.c_str(), [to_dict](System& system, const utility::ScheduleList<SystemType>& schedule_list, std::size_t interval){
+            RandomNumberEngine rng(std::random_device{}());
+            History history;
+            algorithm::Algorithm<Updater>::run(system, rng, schedule_list, history, interval);
+            return to_dict(history);
+            }, "system"_a, "schedule_list"_a, "interval"_a = algorithm::Algorithm<Updater>::once_per_schedule);
+}
+
+//stopping criteria and report of a run
+inline void declare_StoppingCriteria(py::module &m){
+    py::class_<algorithm::StoppingCriteria>(m, "StoppingCriteria")
+        .def(py::init<>())
+        .def(py::init([](std::size_t max_steps_without_acceptance, double target_energy, std::size_t max_schedules_without_improvement){
+                    return algorithm::StoppingCriteria{max_steps_without_acceptance, target_energy, max_schedules_without_improvement};
+                    }), "max_steps_without_acceptance"_a = 0, "target_energy"_a = std::numeric_limits<double>::lowest(), "max_schedules_without_improvement"_a = 0)
+        .def_readwrite("max_steps_without_acceptance", &algorithm::StoppingCriteria::max_steps_without_acceptance)
+        .def_readwrite("target_energy", &algorithm::StoppingCriteria::target_energy)
+        .def_readwrite("max_schedules_without_improvement", &algorithm::StoppingCriteria::max_schedules_without_improvement);
+
+    py::enum_<algorithm::StopReason>(m, "StopReason")
+        .value("completed", algorithm::StopReason::completed)
+        .value("no_acceptance", algorithm::StopReason::no_acceptance)
+        .value("target_energy", algorithm::StopReason::target_energy)
+        .value("no_improvement", algorithm::StopReason::no_improvement);
+
+    py::class_<algorithm::RunReport>(m, "RunReport")
+        .def_readonly("reason", &algorithm::RunReport::reason)
+        .def_readonly("num_steps", &algorithm::RunReport::num_steps)
+        .def_readonly("schedule_index", &algorithm::RunReport::schedule_index);
+}
+
+//adaptive schedule
+inline void declare_AdaptiveSchedule(py::module &m){
+    py::class_<algorithm::AdaptiveSchedule>(m, "AdaptiveSchedule")
+        .def(py::init<>())
+        .def(py::init([](std::size_t num_sweeps, std::size_t sweeps_per_block, double initial_beta,
+                        double initial_acceptance, double final_acceptance, std::size_t max_frozen_blocks){
+                    algorithm::AdaptiveSchedule schedule;
+                    schedule.num_sweeps = num_sweeps;
+                    schedule.sweeps_per_block = sweeps_per_block;
+                    schedule.initial_beta = initial_beta;
+                    schedule.initial_acceptance = initial_acceptance;
+                    schedule.final_acceptance = final_acceptance;
+                    schedule.max_frozen_blocks = max_frozen_blocks;
+                    schedule.validate();
+                    return schedule;
+                    }), "num_sweeps"_a = 1000, "sweeps_per_block"_a = 10, "initial_beta"_a = 1.0,
+                "initial_acceptance"_a = 0.5, "final_acceptance"_a = 0.001, "max_frozen_blocks"_a = 5)
+        .def_readwrite("num_sweeps", &algorithm::AdaptiveSchedule::num_sweeps)
+        .def_readwrite("sweeps_per_block", &algorithm::AdaptiveSchedule::sweeps_per_block)
+        .def_readwrite("initial_beta", &algorithm::AdaptiveSchedule::initial_beta)
+        .def_readwrite("initial_acceptance", &algorithm::AdaptiveSchedule::initial_acceptance)
+        .def_readwrite("final_acceptance", &algorithm::AdaptiveSchedule::final_acceptance)
+        .def_readwrite("warmup_tolerance", &algorithm::AdaptiveSchedule::warmup_tolerance)
+        .def_readwrite("max_warmup_blocks", &algorithm::AdaptiveSchedule::max_warmup_blocks)
+        .def_readwrite("max_beta_factor", &algorithm::AdaptiveSchedule::max_beta_factor)
+        .def_readwrite("max_frozen_blocks", &algorithm::AdaptiveSchedule::max_frozen_blocks);
+
+    py::class_<algorithm::AdaptiveScheduleReport>(m, "AdaptiveScheduleReport")
+        .def_readonly("schedule_list", &algorithm::AdaptiveScheduleReport::schedule_list)
+        .def_property_readonly("acceptance_ratio", [](const algorithm::AdaptiveScheduleReport& self){
+                return py::array_t<double>(self.acceptance_ratio.size(), self.acceptance_ratio.data());
+                })
+        .def_readonly("num_warmup_blocks", &algorithm::AdaptiveScheduleReport::num_warmup_blocks)
+        .def_readonly("num_sweeps", &algorithm::AdaptiveScheduleReport::num_sweeps)
+        .def_readonly("frozen", &algorithm::AdaptiveScheduleReport::frozen);
+}
+
+//Algorithm with adaptive schedule (for the classical systems which have observables)
+template<template<typename> class Updater, typename System, typename RandomNumberEngine>
+inline void declare_Algorithm_run_adaptive(py::module &m, const std::string& updater_str){
+    auto str = std::string("Algorithm_")+updater_str+std::string("_run_adaptive");
+
+    //with seed
+    m.def(str.c_str(), [](System& system, std::size_t seed, const algorithm::AdaptiveSchedule& schedule){
+            RandomNumberEngine rng(seed);
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule);
+            }, "system"_a, "seed"_a, "adaptive_schedule"_a);
+
+    //without seed
+    m.def(str.c_str(), [](System& system, const algorithm::AdaptiveSchedule& schedule){
+            RandomNumberEngine rng(std::random_device{}());
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule);
+            }, "system"_a, "adaptive_schedule"_a);
+}
+
+//tabu search
+inline void declare_TabuSearch(py::module &m){
+    py::class_<algorithm::TabuSearchParameter>(m, "TabuSearchParameter")
+        .def(py::init<>())
+        .def(py::init([](std::size_t num_iterations, std::size_t tenure, std::size_t num_restarts,
+                        std::size_t max_stagnation, double restart_perturbation){
+                    algorithm::TabuSearchParameter parameter;
+                    parameter.num_iterations = num_iterations;
+                    parameter.tenure = tenure;
+                    parameter.num_restarts = num_restarts;
+                    parameter.max_stagnation = max_stagnation;
+                    parameter.restart_perturbation = restart_perturbation;
+                    parameter.validate();
+                    return parameter;
+                    }), "num_iterations"_a = 10000, "tenure"_a = 0, "num_restarts"_a = 10,
+                "max_stagnation"_a = 1000, "restart_perturbation"_a = 0.25)
+        .def_readwrite("num_iterations", &algorithm::TabuSearchParameter::num_iterations)
+        .def_readwrite("tenure", &algorithm::TabuSearchParameter::tenure)
+        .def_readwrite("num_restarts", &algorithm::TabuSearchParameter::num_restarts)
+        .def_readwrite("max_stagnation", &algorithm::TabuSearchParameter::max_stagnation)
+        .def_readwrite("restart_perturbation", &algorithm::TabuSearchParameter::restart_perturbation);
+
+    py::class_<algorithm::TabuSearchReport>(m, "TabuSearchReport")
+        .def_readonly("best_energy", &algorithm::TabuSearchReport::best_energy)
+        .def_readonly("num_iterations", &algorithm::TabuSearchReport::num_iterations)
+        .def_readonly("num_runs", &algorithm::TabuSearchReport::num_runs);
+}
+
+template<typename System, typename RandomNumberEngine>
+inline void declare_TabuSearch_run(py::module &m){
+    //with seed
+    m.def("Algorithm_TabuSearch_run", [](System& system, std::size_t seed, const algorithm::TabuSearchParameter& parameter){
+            RandomNumberEngine rng(seed);
+            return algorithm::TabuSearch::run(system, rng, parameter);
+            }, "system"_a, "seed"_a, "parameter"_a);
+
+    //without seed
+    m.def("Algorithm_TabuSearch_run", [](System& system, const algorithm::TabuSearchParameter& parameter){
+            RandomNumberEngine rng(std::random_device{}());
+            return algorithm::TabuSearch::run(system, rng, parameter);
+            }, "system"_a, "parameter"_a);
+}
+
+//steepest descent (returns the number of flips)
+template<typename System>
+inline void declare_SteepestDescent_run(py::module &m){
+    m.def("Algorithm_SteepestDescent_run", [](System& system){
+            return algorithm::SteepestDescent::run(system);
+            }, "system"_a);
+}
+
+//Algorithm with stopping criteria (for the systems which have observables)
+template<template<typename> class Updater, typename System, typename RandomNumberEngine>
+inline void declare_Algorithm_run_with_stopping_criteria(py::module &m, const std::string& updater_str){
+    auto str = std::string("Algorithm_")+updater_str+std::string("_run_with_stopping_criteria");
+    using SystemType = typename system::get_system_type<System>::type;
+
+    //with seed
+    m.def(str.c_str(), [](System& system, std::size_t seed, const utility::ScheduleList<SystemType>& schedule_list, const algorithm::StoppingCriteria& criteria){
+            RandomNumberEngine rng(seed);
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule_list, criteria);
+            }, "system"_a, "seed"_a, "schedule_list"_a, "stopping_criteria"_a);
+
+    //without seed
+    m.def(str.c_str(), [](System& system, const utility::ScheduleList<SystemType>& schedule_list, const algorithm::StoppingCriteria& criteria){
             RandomNumberEngine rng(std::random_device{}());
-            algorithm::Algorithm<Updater>::run(system, rng, utility::make_schedule_list<SystemType>(tuplelist),
-                    callback ? [=](const System& system, const utility::UpdaterParameter<SystemType>& param){callback(system, param.get_tuple());} : Callback(nullptr));
-            }, "system"_a, "tuplelist"_a, "callback"_a = nullptr);
+            return algorithm::Algorithm<Updater>::run(system, rng, schedule_list, criteria);
+            }, "system"_a, "schedule_list"_a, "stopping_criteria"_a);
+}
 
+//Algorithm resumable from a position in the schedule list (with random number engine object)
+template<template<typename> class Updater, typename System, typename RandomNumberEngine>
+inline void declare_Algorithm_run_from(py::module &m, const std::string& updater_str){
+    auto str = std::string("Algorithm_")+updater_str+std::string("_run_from");
+    using SystemType = typename system::get_system_type<System>::type;
+
+    m.def(str.c_str(), [](System& system, RandomNumberEngine& rng, const utility::ScheduleList<SystemType>& schedule_list,
+                utility::SchedulePosition& position, std::size_t max_steps){
+            return algorithm::Algorithm<Updater>::run_from(system, rng, schedule_list, position, max_steps);
+            }, "system"_a, "random_number_engine"_a, "schedule_list"_a, "position"_a, "max_steps"_a = std::numeric_limits<std::size_t>::max());
+}
+
+//Houdayer (two replicas)
+template<typename System, typename RandomNumberEngine>
+inline void declare_Houdayer_run(py::module &m){
+    using SystemType = typename system::get_system_type<System>::type;
+    //with seed
+    m.def("Algorithm_Houdayer_run", [](System& replica_a, System& replica_b, std::size_t seed, const utility::ScheduleList<SystemType>& schedule_list){
+            RandomNumberEngine rng(seed);
+            for(auto&& schedule : schedule_list){
+                for(std::size_t i = 0; i < schedule.one_mc_step; ++i){
+                    updater::Houdayer<System>::update(replica_a, replica_b, rng, schedule.updater_parameter);
+                }
+            }
+            }, "replica_a"_a, "replica_b"_a, "seed"_a, "schedule_list"_a);
+
+    //without seed
+    m.def("Algorithm_Houdayer_run", [](System& replica_a, System& replica_b, const utility::ScheduleList<SystemType>& schedule_list){
+            RandomNumberEngine rng(std::random_device{}());
+            for(auto&& schedule : schedule_list){
+                for(std::size_t i = 0; i < schedule.one_mc_step; ++i){
+                    updater::Houdayer<System>::update(replica_a, replica_b, rng, schedule.updater_parameter);
+                }
+            }
+            }, "replica_a"_a, "replica_b"_a, "schedule_list"_a);
 }
 
 //utility
@@ -363,6 +842,158 @@ inline void declare_Schedule(py::module &m, const std::string& systemtype_str){
 
 }
 
+//curves of annealing parameter
+inline void declare_Curves(py::module &m){
+    py::class_<utility::LinearCurve>(m, "LinearCurve")
+        .def(py::init<double, double, std::size_t>(), "begin"_a, "end"_a, "num_call_updater"_a)
+        .def("__len__", &utility::LinearCurve::size)
+        .def("__call__", &utility::LinearCurve::operator(), "index"_a);
+
+    py::class_<utility::GeometricCurve>(m, "GeometricCurve")
+        .def(py::init<double, double, std::size_t>(), "begin"_a, "end"_a, "num_call_updater"_a)
+        .def("__len__", &utility::GeometricCurve::size)
+        .def("__call__", &utility::GeometricCurve::operator(), "index"_a);
+
+    py::class_<utility::PowerCurve>(m, "PowerCurve")
+        .def(py::init<double, double, double, std::size_t>(), "begin"_a, "end"_a, "exponent"_a, "num_call_updater"_a)
+        .def("__len__", &utility::PowerCurve::size)
+        .def("__call__", &utility::PowerCurve::operator(), "index"_a);
+
+    py::class_<utility::PiecewiseLinearCurve>(m, "PiecewiseLinearCurve")
+        .def(py::init<std::vector<utility::PiecewiseLinearCurve::Knot>>(), "knots"_a)
+        .def("__len__", &utility::PiecewiseLinearCurve::size)
+        .def("__call__", &utility::PiecewiseLinearCurve::operator(), "index"_a);
+}
+
+//schedule generator
+template<typename SystemType, typename Curve>
+inline void declare_ScheduleGenerator(py::module &m, const std::string& systemtype_str, const std::string& curve_str){
+    using Generator = utility::ScheduleGenerator<SystemType, Curve>;
+    auto str = systemtype_str + curve_str + "Schedule";
+    auto cls = py::class_<Generator>(m, str.c_str());
+    if constexpr (std::is_same<SystemType, system::transverse_field_system>::value){
+        cls.def(py::init<double, const Curve&, std::size_t>(), "beta"_a, "curve"_a, "one_mc_step"_a)
+            .def_readwrite("beta", &Generator::beta);
+    }
+    else{
+        cls.def(py::init<const Curve&, std::size_t>(), "curve"_a, "one_mc_step"_a);
+    }
+    cls.def_readwrite("curve", &Generator::curve)
+        .def_readwrite("one_mc_step", &Generator::one_mc_step)
+        .def("__len__", &Generator::size)
+        .def("__getitem__", [](const Generator& self, std::size_t index){
+                if(index >= self.size()){
+                    throw py::index_error();
+                }
+                return self[index];
+                }, "index"_a)
+        .def("materialize", &Generator::materialize);
+}
+
+//schedule list from numpy arrays (in one call)
+inline void declare_make_schedule_list_from_arrays(py::module &m){
+    using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+    using StepArray = py::array_t<std::size_t, py::array::c_style | py::array::forcecast>;
+
+    //one_mc_step can be a scalar
+    auto check_size = [](std::size_t size, const StepArray& one_mc_step){
+        if(one_mc_step.size() != 1 && static_cast<std::size_t>(one_mc_step.size()) != size){
+            throw std::invalid_argument("sizes of the arrays do not match");
+        }
+    };
+
+    m.def("make_classical_schedule_list_from_arrays", [check_size](const DoubleArray& beta, const StepArray& one_mc_step){
+            check_size(beta.size(), one_mc_step);
+            const double* b = beta.data();
+            const std::size_t* steps = one_mc_step.data();
+            const std::size_t stride = (one_mc_step.size() == 1) ? 0 : 1;
+            utility::ClassicalScheduleList schedule_list(beta.size());
+            for(std::size_t i = 0; i < schedule_list.size(); i++){
+                schedule_list[i].updater_parameter = utility::ClassicalUpdaterParameter(b[i]);
+                schedule_list[i].one_mc_step = steps[i*stride];
+            }
+            return schedule_list;
+            }, "beta"_a, "one_mc_step"_a);
+
+    m.def("make_transverse_field_schedule_list_from_arrays", [check_size](const DoubleArray& beta, const DoubleArray& s, const StepArray& one_mc_step){
+            check_size(s.size(), one_mc_step);
+            if(beta.size() != 1 && beta.size() != s.size()){
+                throw std::invalid_argument("sizes of the arrays do not match");
+            }
+            const double* b = beta.data();
+            const double* ss = s.data();
+            const std::size_t* steps = one_mc_step.data();
+            const std::size_t beta_stride = (beta.size() == 1) ? 0 : 1;
+            const std::size_t step_stride = (one_mc_step.size() == 1) ? 0 : 1;
+            utility::TransverseFieldScheduleList schedule_list(s.size());
+            for(std::size_t i = 0; i < schedule_list.size(); i++){
+                schedule_list[i].updater_parameter = utility::TransverseFieldUpdaterParameter(b[i*beta_stride], ss[i]);
+                schedule_list[i].one_mc_step = steps[i*step_stride];
+            }
+            return schedule_list;
+            }, "beta"_a, "s"_a, "one_mc_step"_a);
+}
+
+//estimation of beta range (computed in C++, in parallel if OpenMP is enabled)
+template<typename GraphType>
+inline void declare_estimate_beta_range(py::module &m){
+    m.def("estimate_delta_energy_range", [](const GraphType& graph){
+            const auto range = utility::estimate_delta_energy_range(graph);
+            return std::make_pair(range.min_delta_energy, range.max_delta_energy);
+            }, "graph"_a);
+
+    m.def("estimate_beta_range", [](const GraphType& graph, double initial_acceptance, double final_acceptance){
+            const auto range = utility::estimate_beta_range(graph, initial_acceptance, final_acceptance);
+            return std::make_pair(range.beta_min, range.beta_max);
+            }, "graph"_a, "initial_acceptance"_a = 0.5, "final_acceptance"_a = 0.01);
+}
+
+//random number engine (the state can be pickled)
+template<typename RandomNumberEngine>
+inline py::class_<RandomNumberEngine> declare_RandomEngine(py::module &m, const std::string& engine_str){
+    return py::class_<RandomNumberEngine>(m, engine_str.c_str())
+        .def(py::init([](std::size_t seed){return RandomNumberEngine(seed);}), "seed"_a)
+        .def(py::init([](){return RandomNumberEngine(std::random_device{}());}))
+        .def("__call__", [](RandomNumberEngine& self){return self();})
+        .def(py::self == py::self)
+        .def(py::pickle(
+                    [](const RandomNumberEngine& self){
+                        std::ostringstream oss;
+                        oss << self;
+                        return oss.str();
+                    },
+                    [](const std::string& state){
+                        RandomNumberEngine engine(0);
+                        std::istringstream iss(state);
+                        if(!(iss >> engine)){
+                            throw std::runtime_error("invalid state of random number engine");
+                        }
+                        return engine;
+                    }));
+}
+
+//position in schedule list
+inline void declare_SchedulePosition(py::module &m){
+    py::class_<utility::SchedulePosition>(m, "SchedulePosition")
+        .def(py::init<>())
+        .def_readwrite("schedule_index", &utility::SchedulePosition::schedule_index)
+        .def_readwrite("step", &utility::SchedulePosition::step)
+        .def("__repr__", [](const utility::SchedulePosition& self){
+                return "(schedule_index: " + std::to_string(self.schedule_index) + " step: " + std::to_string(self.step) + ")";
+                });
+}
+
+//checkpoint
+template<typename System, typename RandomNumberEngine>
+inline void declare_checkpoint(py::module &m){
+    m.def("save_checkpoint", [](const std::string& filename, const System& system, const RandomNumberEngine& rng, const utility::SchedulePosition& position, bool exact_replay){
+            utility::save_checkpoint(filename, system, rng, position, exact_replay);
+            }, "filename"_a, "system"_a, "random_number_engine"_a, "position"_a, "exact_replay"_a = false);
+    m.def("load_checkpoint", [](const std::string& filename, System& system, RandomNumberEngine& rng){
+            return utility::load_checkpoint(filename, system, rng);
+            }, "filename"_a, "system"_a, "random_number_engine"_a);
+}
+
 //result
 //get_solution
 template<typename System>
@@ -370,6 +1001,18 @@ inline void declare_get_solution(py::module &m){
     m.def("get_solution", [](const System& system){return result::get_solution(system);}, "system"_a);
 }
 
+//get_best_solution
+template<typename System>
+inline void declare_get_best_solution(py::module &m){
+    m.def("get_best_solution", [](const System& system){return result::get_best_solution(system);}, "system"_a);
+}
+
+//get_energy
+template<typename System>
+inline void declare_get_energy(py::module &m){
+    m.def("get_energy", [](const System& system){return result::get_energy(system);}, "system"_a);
+}
+
 
 
 #endif
@@ -23,6 +23,157 @@
 #include <pybind11_json/pybind11_json.hpp>
 
 
+/**
+ * @brief register the graphs, systems, algorithms and results with the given floating point precision
+ *
+ * @tparam FloatType floating point precision
+ * @param suffix suffix of the class names (empty for the default precision)
+ */
+template<typename FloatType>
+void declare_precision(py::module& m_graph, py::module& m_system, py::module& m_algorithm, py::module& m_utility, py::module& m_result, const std::string& suffix){
+
+    /**********************************************************
+    //namespace graph
+     **********************************************************/
+    ::declare_Dense<FloatType>(m_graph, suffix);
+    ::declare_Sparse<FloatType>(m_graph, suffix);
+    ::declare_Square<FloatType>(m_graph, suffix);
+    ::declare_Chimera<FloatType>(m_graph, suffix);
+
+    /**********************************************************
+    //namespace system 
+     **********************************************************/
+    //ClassicalIsing
+    ::declare_Observables<FloatType>(m_system, suffix);
+
+    ::declare_ClassicalIsing<graph::Dense<FloatType>>(m_system, "_Dense"+suffix);
+    ::declare_ClassicalIsing<graph::Sparse<FloatType>>(m_system, "_Sparse"+suffix);
+
+    //TransverselIsing
+    ::declare_TransverseIsing<graph::Dense<FloatType>>(m_system, "_Dense"+suffix);
+    ::declare_TransverseIsing<graph::Sparse<FloatType>>(m_system, "_Sparse"+suffix);
+
+    //Transverse Ising with packed trotter spins
+    ::declare_PackedTransverseIsing<graph::Sparse<FloatType>>(m_system, "_Sparse"+suffix);
+
+    //Continuous Time Transeverse Ising
+    ::declare_ContinuousTimeIsing<graph::Sparse<FloatType>>(m_system, "_Sparse"+suffix);
+
+    /**********************************************************
+    //namespace algorithm
+     **********************************************************/
+    //singlespinflip
+    ::declare_Algorithm_run<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>,    RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>,   RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run<updater::SingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>,   RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run<updater::SingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run<updater::SingleSpinFlip, system::PackedTransverseIsing<graph::Sparse<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+
+    //parallel singlespinflip (even/odd trotter slices)
+    ::declare_Algorithm_run<updater::ParallelSingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>,   RandomEngine>(m_algorithm, "ParallelSingleSpinFlip");
+    ::declare_Algorithm_run<updater::ParallelSingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>,  RandomEngine>(m_algorithm, "ParallelSingleSpinFlip");
+
+    //swendsen-wang
+    ::declare_Algorithm_run<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "SwendsenWang");
+
+    //rejection-free n-fold way
+    ::declare_Algorithm_run<updater::NFoldWay, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "NFoldWay");
+
+    //history of observables
+    ::declare_Algorithm_run_with_history<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_history<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_history<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>,   RandomEngine>(m_algorithm, "SwendsenWang");
+    ::declare_Algorithm_run_with_history<updater::NFoldWay, system::ClassicalIsing<graph::Sparse<FloatType>>,       RandomEngine>(m_algorithm, "NFoldWay");
+
+    //stopping criteria
+    ::declare_Algorithm_run_with_stopping_criteria<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_stopping_criteria<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_stopping_criteria<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>,   RandomEngine>(m_algorithm, "SwendsenWang");
+    ::declare_Algorithm_run_with_stopping_criteria<updater::NFoldWay, system::ClassicalIsing<graph::Sparse<FloatType>>,       RandomEngine>(m_algorithm, "NFoldWay");
+
+    //adaptive schedule
+    ::declare_Algorithm_run_adaptive<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_adaptive<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "SingleSpinFlip");
+
+    //tabu search
+    ::declare_TabuSearch_run<system::ClassicalIsing<graph::Dense<FloatType>>,  RandomEngine>(m_algorithm);
+    ::declare_TabuSearch_run<system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm);
+
+    //steepest descent
+    ::declare_SteepestDescent_run<system::ClassicalIsing<graph::Dense<FloatType>>>(m_algorithm);
+    ::declare_SteepestDescent_run<system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm);
+
+    //Continuous time swendsen-wang
+    ::declare_Algorithm_run<updater::ContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "ContinuousTimeSwendsenWang");
+    ::declare_Algorithm_run<updater::ParallelContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "ParallelContinuousTimeSwendsenWang");
+
+    //resumable run
+    ::declare_Algorithm_run_from<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>,    RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_from<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>,   RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_from<updater::SingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>,   RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_from<updater::SingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_from<updater::ParallelSingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>,   RandomEngine>(m_algorithm, "ParallelSingleSpinFlip");
+    ::declare_Algorithm_run_from<updater::ParallelSingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>,  RandomEngine>(m_algorithm, "ParallelSingleSpinFlip");
+    ::declare_Algorithm_run_from<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "SwendsenWang");
+    ::declare_Algorithm_run_from<updater::NFoldWay, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "NFoldWay");
+    ::declare_Algorithm_run_from<updater::ContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "ContinuousTimeSwendsenWang");
+    ::declare_Algorithm_run_from<updater::ParallelContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "ParallelContinuousTimeSwendsenWang");
+
+    //houdayer (two replicas)
+    ::declare_Houdayer_run<system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm);
+
+    //random number engine given as an object
+    ::declare_Algorithm_run_with_engines<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::SingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::SingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::SingleSpinFlip, system::PackedTransverseIsing<graph::Sparse<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::ParallelSingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>>(m_algorithm, "ParallelSingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::ParallelSingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>>(m_algorithm, "ParallelSingleSpinFlip");
+    ::declare_Algorithm_run_with_engines<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm, "SwendsenWang");
+    ::declare_Algorithm_run_with_engines<updater::NFoldWay, system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm, "NFoldWay");
+    ::declare_Algorithm_run_with_engines<updater::ContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>>(m_algorithm, "ContinuousTimeSwendsenWang");
+    ::declare_Algorithm_run_with_engines<updater::ParallelContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>>(m_algorithm, "ParallelContinuousTimeSwendsenWang");
+
+    //independent replicas in parallel
+    ::declare_Algorithm_run_replicas<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_replicas<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_replicas<updater::SingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_replicas<updater::SingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>>(m_algorithm, "SingleSpinFlip");
+    ::declare_Algorithm_run_replicas<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm, "SwendsenWang");
+    ::declare_Algorithm_run_replicas<updater::NFoldWay, system::ClassicalIsing<graph::Sparse<FloatType>>>(m_algorithm, "NFoldWay");
+
+    /**********************************************************
+    //namespace utlity
+     **********************************************************/
+    //beta range
+    ::declare_estimate_beta_range<graph::Dense<FloatType>>(m_utility);
+    ::declare_estimate_beta_range<graph::Sparse<FloatType>>(m_utility);
+
+    //checkpoint
+    ::declare_checkpoint<system::ClassicalIsing<graph::Dense<FloatType>>,  RandomEngine>(m_utility);
+    ::declare_checkpoint<system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_utility);
+    ::declare_checkpoint<system::TransverseIsing<graph::Dense<FloatType>>,  RandomEngine>(m_utility);
+    ::declare_checkpoint<system::TransverseIsing<graph::Sparse<FloatType>>, RandomEngine>(m_utility);
+    ::declare_checkpoint<system::ContinuousTimeIsing<graph::Sparse<FloatType>>, RandomEngine>(m_utility);
+
+    /**********************************************************
+    //namespace result
+     **********************************************************/
+    ::declare_get_solution<system::ClassicalIsing<graph::Dense<FloatType>>>(m_result);
+    ::declare_get_solution<system::ClassicalIsing<graph::Sparse<FloatType>>>(m_result);
+    ::declare_get_solution<system::TransverseIsing<graph::Dense<FloatType>>>(m_result);
+    ::declare_get_solution<system::TransverseIsing<graph::Sparse<FloatType>>>(m_result);
+    ::declare_get_solution<system::PackedTransverseIsing<graph::Sparse<FloatType>>>(m_result);
+    ::declare_get_solution<system::ContinuousTimeIsing<graph::Sparse<FloatType>>>(m_result);
+
+    ::declare_get_best_solution<system::ClassicalIsing<graph::Dense<FloatType>>>(m_result);
+    ::declare_get_best_solution<system::ClassicalIsing<graph::Sparse<FloatType>>>(m_result);
+
+    ::declare_get_energy<system::TransverseIsing<graph::Dense<FloatType>>>(m_result);
+    ::declare_get_energy<system::TransverseIsing<graph::Sparse<FloatType>>>(m_result);
+}
+
 PYBIND11_MODULE(cxxjij, m){
     m.doc() = "openjij is a framework for ising and qubo";
 
@@ -36,41 +187,13 @@ PYBIND11_MODULE(cxxjij, m){
     ::declare_Dir(m_graph);
     ::declare_ChimeraDir(m_graph);
 
-    //CPU version (FloatType)
-    ::declare_Dense<FloatType>(m_graph, "");
-    ::declare_Sparse<FloatType>(m_graph, "");
-    ::declare_Square<FloatType>(m_graph, "");
-    ::declare_Chimera<FloatType>(m_graph, "");
-
-    //GPU version (GPUFloatType)
-    if(!std::is_same<FloatType, GPUFloatType>::value){
-        ::declare_Dense<GPUFloatType>(m_graph, "GPU");
-        ::declare_Sparse<GPUFloatType>(m_graph, "GPU");
-        ::declare_Square<GPUFloatType>(m_graph, "GPU");
-        ::declare_Chimera<GPUFloatType>(m_graph, "GPU");
-    }
-    else{
-        //raise warning
-        std::cerr << "Warning: please use classes in Graph module without suffix \"GPU\" or define type aliases." << std::endl;
-    }
-
+    //Dense, Sparse, Square and Chimera are registered for each precision below
 
     /**********************************************************
     //namespace system 
      **********************************************************/
     py::module m_system = m.def_submodule("system", "cxxjij module for system");
 
-    //ClassicalIsing
-    ::declare_ClassicalIsing<graph::Dense<FloatType>>(m_system, "_Dense");
-    ::declare_ClassicalIsing<graph::Sparse<FloatType>>(m_system, "_Sparse");
-
-    //TransverselIsing
-    ::declare_TransverseIsing<graph::Dense<FloatType>>(m_system, "_Dense");
-    ::declare_TransverseIsing<graph::Sparse<FloatType>>(m_system, "_Sparse");
-
-    //Continuous Time Transeverse Ising
-    ::declare_ContinuousTimeIsing<graph::Sparse<FloatType>>(m_system, "_Sparse");
-
 #ifdef USE_CUDA
     //ChimeraTransverseGPU
     ::declare_ChimeraTranseverseGPU<GPUFloatType, BLOCK_ROW, BLOCK_COL, BLOCK_TROT>(m_system);
@@ -83,17 +206,14 @@ PYBIND11_MODULE(cxxjij, m){
      **********************************************************/
     py::module m_algorithm = m.def_submodule("algorithm", "cxxjij module for algorithm");
 
-    //singlespinflip
-    ::declare_Algorithm_run<updater::SingleSpinFlip, system::ClassicalIsing<graph::Dense<FloatType>>,    RandomEngine>(m_algorithm, "SingleSpinFlip");
-    ::declare_Algorithm_run<updater::SingleSpinFlip, system::ClassicalIsing<graph::Sparse<FloatType>>,   RandomEngine>(m_algorithm, "SingleSpinFlip");
-    ::declare_Algorithm_run<updater::SingleSpinFlip, system::TransverseIsing<graph::Dense<FloatType>>,   RandomEngine>(m_algorithm, "SingleSpinFlip");
-    ::declare_Algorithm_run<updater::SingleSpinFlip, system::TransverseIsing<graph::Sparse<FloatType>>,  RandomEngine>(m_algorithm, "SingleSpinFlip");
+    //stopping criteria
+    ::declare_StoppingCriteria(m_algorithm);
 
-    //swendsen-wang
-    ::declare_Algorithm_run<updater::SwendsenWang, system::ClassicalIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "SwendsenWang");
+    //adaptive schedule
+    ::declare_AdaptiveSchedule(m_algorithm);
 
-    //Continuous time swendsen-wang
-    ::declare_Algorithm_run<updater::ContinuousTimeSwendsenWang, system::ContinuousTimeIsing<graph::Sparse<FloatType>>, RandomEngine>(m_algorithm, "ContinuousTimeSwendsenWang");
+    //tabu search
+    ::declare_TabuSearch(m_algorithm);
 
 #ifdef USE_CUDA
     //GPU
@@ -138,6 +258,33 @@ PYBIND11_MODULE(cxxjij, m){
     ::declare_Schedule<system::classical_system>(m_utility, "Classical");
     ::declare_Schedule<system::transverse_field_system>(m_utility, "TransverseField");
 
+    //schedule generators (lazy schedule lists)
+    ::declare_Curves(m_utility);
+    ::declare_ScheduleGenerator<system::classical_system, utility::LinearCurve>(m_utility, "Classical", "Linear");
+    ::declare_ScheduleGenerator<system::classical_system, utility::GeometricCurve>(m_utility, "Classical", "Geometric");
+    ::declare_ScheduleGenerator<system::classical_system, utility::PowerCurve>(m_utility, "Classical", "Power");
+    ::declare_ScheduleGenerator<system::classical_system, utility::PiecewiseLinearCurve>(m_utility, "Classical", "PiecewiseLinear");
+    ::declare_ScheduleGenerator<system::transverse_field_system, utility::LinearCurve>(m_utility, "TransverseField", "Linear");
+    ::declare_ScheduleGenerator<system::transverse_field_system, utility::GeometricCurve>(m_utility, "TransverseField", "Geometric");
+    ::declare_ScheduleGenerator<system::transverse_field_system, utility::PowerCurve>(m_utility, "TransverseField", "Power");
+    ::declare_ScheduleGenerator<system::transverse_field_system, utility::PiecewiseLinearCurve>(m_utility, "TransverseField", "PiecewiseLinear");
+    ::declare_make_schedule_list_from_arrays(m_utility);
+
+    //random number engines (RandomEngine is the default one, which is used if a seed is given)
+    ::declare_RandomEngine<utility::Xorshift>(m_utility, "Xorshift");
+    ::declare_RandomEngine<std::mt19937>(m_utility, "MT19937");
+    ::declare_RandomEngine<std::mt19937_64>(m_utility, "MT19937_64");
+    ::declare_RandomEngine<utility::Philox4x32>(m_utility, "Philox4x32")
+        .def(py::init([](std::uint64_t seed, std::uint64_t stream){return utility::Philox4x32(seed, stream);}), "seed"_a, "stream"_a)
+        .def("stream", &utility::Philox4x32::stream);
+    ::declare_RandomEngine<utility::Xoshiro256StarStar>(m_utility, "Xoshiro256StarStar")
+        .def("jump", &utility::Xoshiro256StarStar::jump)
+        .def("long_jump", &utility::Xoshiro256StarStar::long_jump);
+    m_utility.attr("RandomEngine") = py::reinterpret_borrow<py::object>(py::detail::get_type_handle(typeid(RandomEngine), true));
+
+    //position in schedule list
+    ::declare_SchedulePosition(m_utility);
+
     m_utility.def("make_classical_schedule_list", &utility::make_classical_schedule_list,
             "beta_min"_a, "beta_max"_a, "one_mc_step"_a, "num_call_updater"_a);
 
@@ -152,11 +299,34 @@ PYBIND11_MODULE(cxxjij, m){
      **********************************************************/
     py::module m_result = m.def_submodule("result", "cxxjij module for result");
 
-    ::declare_get_solution<system::ClassicalIsing<graph::Dense<FloatType>>>(m_result);
-    ::declare_get_solution<system::ClassicalIsing<graph::Sparse<FloatType>>>(m_result);
-    ::declare_get_solution<system::TransverseIsing<graph::Dense<FloatType>>>(m_result);
-    ::declare_get_solution<system::TransverseIsing<graph::Sparse<FloatType>>>(m_result);
-    ::declare_get_solution<system::ContinuousTimeIsing<graph::Sparse<FloatType>>>(m_result);
+    /**********************************************************
+    //CPU version: the default precision (FloatType) without suffix, and single precision with suffix "Float32"
+     **********************************************************/
+    ::declare_precision<FloatType>(m_graph, m_system, m_algorithm, m_utility, m_result, "");
+    if(!std::is_same<FloatType, float>::value){
+        ::declare_precision<float>(m_graph, m_system, m_algorithm, m_utility, m_result, "Float32");
+    }
+
+    /**********************************************************
+    //GPU version of graphs (GPUFloatType)
+     **********************************************************/
+    if(std::is_same<FloatType, GPUFloatType>::value){
+        //raise warning
+        std::cerr << "Warning: please use classes in Graph module without suffix \"GPU\" or define type aliases." << std::endl;
+    }
+    else if(std::is_same<GPUFloatType, float>::value){
+        //already registered with suffix "Float32"
+        for(const auto& name : {"Dense", "Sparse", "Square", "Chimera"}){
+            m_graph.attr((std::string(name)+"GPU").c_str()) = m_graph.attr((std::string(name)+"Float32").c_str());
+        }
+    }
+    else{
+        ::declare_Dense<GPUFloatType>(m_graph, "GPU");
+        ::declare_Sparse<GPUFloatType>(m_graph, "GPU");
+        ::declare_Square<GPUFloatType>(m_graph, "GPU");
+        ::declare_Chimera<GPUFloatType>(m_graph, "GPU");
+    }
+
 #ifdef USE_CUDA
     ::declare_get_solution<system::ChimeraTransverseGPU<GPUFloatType, BLOCK_ROW, BLOCK_COL, BLOCK_TROT>>(m_result);
     ::declare_get_solution<system::ChimeraClassicalGPU<GPUFloatType, BLOCK_ROW, BLOCK_COL>>(m_result);
@@ -74,20 +74,31 @@ def make_BinaryQuadraticModel(linear: dict, quadratic: dict):
             self.gpu = gpu
     
     
-        def get_cxxjij_ising_graph(self, sparse: bool=False):
+        def get_cxxjij_ising_graph(self, sparse: bool=False, precision: str='float64'):
             """generate cxxjij Ising graph from the interactions.
 
             Args:
                 sparse (bool): if true, this function returns cxxjij.graph.Sparse. Otherwise it returns cxxjij.graph.Dense.
+                precision (str): 'float64' or 'float32'. if 'float32', cxxjij.graph.SparseFloat32 or cxxjij.graph.DenseFloat32 is returned.
             Returns:
                 cxxjij.graph.Dense or cxxjij.graph.Sparse: 
             """
+
+            if precision not in ('float64', 'float32'):
+                raise ValueError("precision must be 'float64' or 'float32', got {}".format(precision))
+            float32 = (precision == 'float32')
     
             if sparse:
-                GraphClass = cxxjij.graph.Sparse if self.gpu == False else cxxjij.graph.SparseGPU
+                if self.gpu:
+                    GraphClass = cxxjij.graph.SparseGPU
+                else:
+                    GraphClass = cxxjij.graph.SparseFloat32 if float32 else cxxjij.graph.Sparse
                 return GraphClass(self.to_serializable())
             else:
-                GraphClass = cxxjij.graph.Dense if self.gpu == False else cxxjij.graph.DenseGPU
+                if self.gpu:
+                    GraphClass = cxxjij.graph.DenseGPU
+                else:
+                    GraphClass = cxxjij.graph.DenseFloat32 if float32 else cxxjij.graph.Dense
                 # initialize with interaction matrix.
                 mat = self.interaction_matrix()
 
@@ -4,4 +4,5 @@ from .sa_sampler import SASampler
 from .sqa_sampler import SQASampler
 from .chimera_gpu import GPUChimeraSQASampler, GPUChimeraSASampler
 from .csqa_sampler import CSQASampler
+from .tabu_sampler import TabuSampler
 from .cmos_annealer import *
@@ -70,7 +70,7 @@ class CSQASampler(SQASampler):
             schedule (list, optional): schedule list
             num_reads (int, optional): number of iterations
             initial_state (optional): initial state of spins
-            updater (str, optional): updater algorithm
+            updater (str, optional): updater algorithm, "swendsen wang" or "parallel swendsen wang" (multi-threaded if built with USE_OMP)
             reinitialize_state (bool, optional): Re-initilization at each sampling. Defaults to True.
             seed (int, optional): Sampling seed.
             structure (int, optional): specify the structure. 
@@ -128,8 +128,10 @@ class CSQASampler(SQASampler):
         _updater_name = updater.lower().replace('_', '').replace(' ', '')
         if _updater_name == 'swendsenwang':
             algorithm = cxxjij.algorithm.Algorithm_ContinuousTimeSwendsenWang_run
+        elif _updater_name == 'parallelswendsenwang':
+            algorithm = cxxjij.algorithm.Algorithm_ParallelContinuousTimeSwendsenWang_run
         else:
-            raise ValueError('updater is one of "swendsen wang"')
+            raise ValueError('updater is one of "swendsen wang", "parallel swendsen wang"')
         # ------------------------------------------- choose updater
 
         response = self._cxxjij_sampling(
@@ -25,6 +25,14 @@ import cxxjij
 This module contains Simulated Annealing sampler.
 """
 
+_classical_schedule_generators = (
+    cxxjij.utility.ClassicalLinearSchedule,
+    cxxjij.utility.ClassicalGeometricSchedule,
+    cxxjij.utility.ClassicalPowerSchedule,
+    cxxjij.utility.ClassicalPiecewiseLinearSchedule
+)
+
+
 class SASampler(BaseSampler):
     """Sampler with Simulated Annealing (SA).
 
@@ -82,46 +90,70 @@ class SASampler(BaseSampler):
 
         self._make_system = {
             'singlespinflip': cxxjij.system.make_classical_ising,
-            'swendsenwang': cxxjij.system.make_classical_ising
+            'swendsenwang': cxxjij.system.make_classical_ising,
+            'nfoldway': cxxjij.system.make_classical_ising
         }
         self._algorithm = {
             'singlespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run,
-            'swendsenwang': cxxjij.algorithm.Algorithm_SwendsenWang_run
+            'swendsenwang': cxxjij.algorithm.Algorithm_SwendsenWang_run,
+            'nfoldway': cxxjij.algorithm.Algorithm_NFoldWay_run
+        }
+        self._algorithm_with_time_budget = {
+            'singlespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run_with_time_budget,
+            'swendsenwang': cxxjij.algorithm.Algorithm_SwendsenWang_run_with_time_budget,
+            'nfoldway': cxxjij.algorithm.Algorithm_NFoldWay_run_with_time_budget
         }
 
 
     def _convert_validation_schedule(self, schedule):
         """Checks if the schedule is valid and returns cxxjij schedule
         """
-        if not isinstance(schedule, (list, np.array)):
+        # schedule generators are evaluated lazily in cxxjij
+        if isinstance(schedule, _classical_schedule_generators):
+            return schedule
+
+        if not isinstance(schedule, (list, np.ndarray)):
             raise ValueError("schedule should be list or numpy.array")
 
         if isinstance(schedule[0], cxxjij.utility.ClassicalSchedule):
             return schedule
 
-        if len(schedule[0]) != 2:
+        schedule = np.asarray(schedule)
+        if schedule.ndim != 2 or schedule.shape[1] != 2:
             raise ValueError(
                 "schedule is list of tuple or list (beta : float, step_length : int)")
 
         # schedule validation  0 <= beta
-        beta = np.array(schedule).T[0]
+        beta = schedule[:, 0]
         if not np.all(0 <= beta):
             raise ValueError("schedule beta range is '0 <= beta'.")
 
-        # convert to cxxjij.utility.ClassicalSchedule
-        cxxjij_schedule = []
-        for beta, step_length in schedule:
-            _schedule = cxxjij.utility.ClassicalSchedule()
-            _schedule.one_mc_step = step_length
-            _schedule.updater_parameter.beta = beta
-            cxxjij_schedule.append(_schedule)
+        # convert to list of cxxjij.utility.ClassicalSchedule in one call
+        return cxxjij.utility.make_classical_schedule_list_from_arrays(
+            beta, schedule[:, 1].astype(np.uint64))
 
-        return cxxjij_schedule
+    def _convert_adaptive_schedule(self, schedule):
+        """Returns cxxjij adaptive schedule, in which beta follows the measured acceptance ratio
+        """
+        if isinstance(schedule, cxxjij.algorithm.AdaptiveSchedule):
+            return schedule
+
+        if schedule != 'adaptive':
+            raise ValueError("schedule should be 'adaptive' if it is a string")
+
+        # beta_min is used as the initial beta, the warm-up corrects it anyway
+        beta_min = self._schedule_setting['beta_min']
+        return cxxjij.algorithm.AdaptiveSchedule(
+            num_sweeps=self._schedule_setting['num_sweeps'],
+            initial_beta=beta_min if beta_min is not None else 1.0
+        )
 
     def sample_ising(self, h, J, beta_min=None, beta_max=None,
                      num_sweeps=None, num_reads=1, schedule=None,
                      initial_state=None, updater='single spin flip',
-                     reinitialize_state=True, seed=None,
+                     reinitialize_state=True, seed=None, keep_best=False,
+                     time_budget=None, precision='float64', random_engine=None,
+                     postprocess=None,
                      ):
         """sample Ising model.
 
@@ -132,11 +164,19 @@ class SASampler(BaseSampler):
             beta_max (float): maximum value of inverse temperature
             num_sweeps (int): number of sweeps
             num_reads (int): number of reads
-            schedule (list): list of inverse temperature
+            schedule (list): list of inverse temperature (list of (beta, step_length), numpy array of shape (n, 2) or cxxjij.utility.Classical*Schedule generator).
+                'adaptive' or cxxjij.algorithm.AdaptiveSchedule makes beta follow the measured acceptance ratio (single spin flip only).
             initial_state (dict): initial state
-            updater(str): updater algorithm
+            updater(str): updater algorithm, 'single spin flip', 'swendsen wang' or 'n fold way' (rejection-free, efficient at low temperature).
+                a change of beta costs O(num_spins) for 'n fold way' unless the energy differences take a few distinct values (e.g. integer couplings),
+                so the default schedule of 'n fold way' makes 10 sweeps at each beta. give a schedule with several sweeps per beta likewise.
             reinitialize_state (bool): if true reinitialize state for each run
             seed (int): seed for Monte Carlo algorithm
+            keep_best (bool): if true keep the lowest-energy state seen during each run, stored in info['best_states'] and info['best_energies']
+            time_budget (float): wall-clock time for all the reads in seconds. if given, the schedule is stretched or compressed to finish on time.
+            precision (str): floating point precision of the interactions, 'float64' or 'float32'
+            random_engine (str): random number engine, 'xorshift', 'mt19937', 'mt19937_64', 'philox4x32' (the i-th read uses the i-th stream) or 'xoshiro256**' (the i-th read uses the i-th jump). if None, the default engine is used.
+            postprocess (str): 'steepest descent' polishes each returned state to a 1-flip local minimum. if None, the states are returned as they are.
         Returns:
             :class:`openjij.sampler.response.Response`: results
             
@@ -163,12 +203,18 @@ class SASampler(BaseSampler):
         return self._sampling(model, beta_min, beta_max,
                               num_sweeps, num_reads, schedule,
                               initial_state, updater,
-                              reinitialize_state, seed)
+                              reinitialize_state, seed,
+                              keep_best=keep_best, time_budget=time_budget,
+                              precision=precision, random_engine=random_engine,
+                              postprocess=postprocess)
 
     def _sampling(self, model, beta_min=None, beta_max=None,
                      num_sweeps=None, num_reads=1, schedule=None,
                      initial_state=None, updater='single spin flip',
                      reinitialize_state=True, seed=None, structure=None, 
+                     keep_best=False, time_budget=None,
+                     precision='float64', random_engine=None,
+                     postprocess=None,
                      ):
         """sampling by using specified model
         Args:
@@ -185,15 +231,22 @@ class SASampler(BaseSampler):
             structure (dict): specify the structure. 
             This argument is necessary if the model has a specific structure (e.g. Chimera graph) and the updater algorithm is structure-dependent.
             structure must have two types of keys, namely "size" which shows the total size of spins and "dict" which is the map from model index (elements in model.indices) to the number.
+            keep_best (bool): if true keep the lowest-energy state seen during each run
+            time_budget (float): wall-clock time for all the reads in seconds
+            precision (str): floating point precision of the interactions, 'float64' or 'float32'
+            random_engine (str): random number engine, 'xorshift', 'mt19937', 'mt19937_64', 'philox4x32' or 'xoshiro256**'
+            postprocess (str): post-processing of each returned state, 'steepest descent' or None
         Returns:
             :class:`openjij.sampler.response.Response`: results
         """
         _updater_name = updater.lower().replace('_', '').replace(' ', '')
-        # swendsen wang algorithm runs only on sparse ising graphs.
-        if _updater_name == 'swendsenwang':
-            ising_graph = model.get_cxxjij_ising_graph(sparse=True)
+        # swendsen wang and n-fold way algorithms run only on sparse ising graphs.
+        if _updater_name in ('swendsenwang', 'nfoldway'):
+            ising_graph = model.get_cxxjij_ising_graph(sparse=True, precision=precision)
         else:
-            ising_graph = model.get_cxxjij_ising_graph()
+            ising_graph = model.get_cxxjij_ising_graph(precision=precision)
+        _random_engine = self._random_engine_class(random_engine)
+        _postprocess = self._postprocess_algorithm(postprocess)
 
 
         self._setting_overwrite(
@@ -203,17 +256,29 @@ class SASampler(BaseSampler):
 
 
         # set annealing schedule -------------------------------
-        if schedule or self.schedule:
+        _given_schedule = schedule if schedule is not None else self.schedule
+        adaptive = isinstance(_given_schedule, (str, cxxjij.algorithm.AdaptiveSchedule))
+        if adaptive:
+            self._schedule = self._convert_adaptive_schedule(_given_schedule)
+            self.schedule_info = {
+                'schedule': 'adaptive',
+                'num_sweeps': self._schedule.num_sweeps
+            }
+        elif self._is_schedule_given(schedule) or self._is_schedule_given(self.schedule):
             self._schedule = self._convert_validation_schedule(
-                schedule if schedule else self.schedule
+                schedule if self._is_schedule_given(schedule) else self.schedule
             )
             self.schedule_info = {'schedule': 'custom schedule'}
         else:
+            # n fold way rebuilds the rates of all the spins at each beta if the energy differences take many distinct values,
+            # so that several sweeps are made at each beta
             self._schedule, beta_range = geometric_ising_beta_schedule(
                 model=model,
                 beta_max=self._schedule_setting['beta_max'],
                 beta_min=self._schedule_setting['beta_min'],
-                num_sweeps=self._schedule_setting['num_sweeps']
+                num_sweeps=self._schedule_setting['num_sweeps'],
+                ising_graph=ising_graph,
+                num_sweeps_per_beta=10 if _updater_name == 'nfoldway' else None
             )
             self.schedule_info = {
                 'beta_max': beta_range[0],
@@ -250,20 +315,59 @@ class SASampler(BaseSampler):
         # choose updater -------------------------------------------
         _updater_name = updater.lower().replace('_', '').replace(' ', '')
         if _updater_name not in self._make_system:
-            raise ValueError('updater is one of "single spin flip or swendsen wang"')
+            raise ValueError('updater is one of "single spin flip", "swendsen wang" or "n fold way"')
         algorithm = self._algorithm[_updater_name]
+        if adaptive:
+            if _updater_name != 'singlespinflip':
+                raise ValueError('adaptive schedule is only for single spin flip')
+            if time_budget is not None:
+                raise ValueError('adaptive schedule cannot be used with time_budget')
+            if _random_engine is not None:
+                raise ValueError('adaptive schedule cannot be used with random_engine')
+            algorithm = cxxjij.algorithm.Algorithm_SingleSpinFlip_run_adaptive
+        elif time_budget is not None:
+            if _random_engine is not None:
+                raise ValueError('time_budget cannot be used with random_engine')
+            algorithm = self._time_budget_algorithm(
+                self._algorithm_with_time_budget[_updater_name], time_budget)
         sa_system = self._make_system[_updater_name](_generate_init_state(), ising_graph)
+        sa_system.track_best_spin = keep_best
         # ------------------------------------------- choose updater
         response = self._cxxjij_sampling(
             model, _generate_init_state,
             algorithm, sa_system,
-            reinitialize_state, seed, structure
+            reinitialize_state, seed, structure,
+            random_engine=_random_engine, postprocess=_postprocess
         )
 
+        # best states seen in each run ------------------------------
+        if keep_best:
+            best_states = []
+            for sys_info in response.info['system']:
+                best_state = sys_info.pop('best_state')
+                if structure is None:
+                    best_states.append({ind: best_state[k] for k, ind in enumerate(model.indices)})
+                else:
+                    best_states.append({ind: best_state[structure['dict'][ind]] for ind in model.indices})
+            response.info['best_states'] = best_states
+            response.info['best_energies'] = np.array([model.energy(state) for state in best_states])
+            response.info['system'] = [sys_info for sys_info in response.info['system'] if sys_info]
+        # ------------------------------ best states seen in each run
+
         response.info['schedule'] = self.schedule_info
+        if time_budget is not None:
+            response.info['time_budget'] = time_budget
+        if postprocess is not None:
+            response.info['postprocess'] = postprocess
 
         return response
 
+    def _get_result(self, system, model):
+        result, sys_info = super()._get_result(system, model)
+        if system.track_best_spin:
+            sys_info['best_state'] = cxxjij.result.get_best_solution(system)
+        return result, sys_info
+
     def sample_hubo(self, interactions: list, var_type,
                     beta_min=None, beta_max=None, schedule=None,
                     num_sweeps=100, num_reads=1,
@@ -330,7 +434,8 @@ class SASampler(BaseSampler):
 
 def geometric_ising_beta_schedule(model: openjij.model.BinaryQuadraticModel,
                                   beta_max=None, beta_min=None,
-                                  num_sweeps=1000):
+                                  num_sweeps=1000, ising_graph=None,
+                                  num_sweeps_per_beta=None):
     """make geometric cooling beta schedule
 
     Args:
@@ -338,9 +443,18 @@ def geometric_ising_beta_schedule(model: openjij.model.BinaryQuadraticModel,
         beta_max (float, optional): [description]. Defaults to None.
         beta_min (float, optional): [description]. Defaults to None.
         num_sweeps (int, optional): [description]. Defaults to 1000.
+        ising_graph (cxxjij.graph.Dense or cxxjij.graph.Sparse, optional): cxxjij graph of the model. if given, the beta range is estimated in C++.
+        num_sweeps_per_beta (int, optional): if given, num_sweeps sweeps are divided into num_sweeps / num_sweeps_per_beta values of beta. Defaults to None (num_sweeps values of beta with max(1, num_sweeps // 1000) sweeps each).
     Returns:
         list of cxxjij.utility.ClassicalSchedule, list of beta range [max, min]
     """
+    if (beta_min is None or beta_max is None) and isinstance(ising_graph, (cxxjij.graph.Dense, cxxjij.graph.Sparse,
+                                                                         cxxjij.graph.DenseFloat32, cxxjij.graph.SparseFloat32)):
+        _beta_min, _beta_max = cxxjij.utility.estimate_beta_range(
+            ising_graph, initial_acceptance=0.5, final_acceptance=0.01)
+        beta_min = _beta_min if beta_min is None else beta_min
+        beta_max = _beta_max if beta_max is None else beta_max
+
     if beta_min is None or beta_max is None:
         # generate Ising matrix
         ising_interaction = model.interaction_matrix()
@@ -361,13 +475,17 @@ def geometric_ising_beta_schedule(model: openjij.model.BinaryQuadraticModel,
     beta_min = np.log(2) / max_delta_energy if beta_min is None else beta_min
     beta_max = np.log(100) / min_delta_energy if beta_max is None else beta_max
 
-    num_sweeps_per_beta = max(1, num_sweeps // 1000)
+    if num_sweeps_per_beta is None:
+        num_sweeps_per_beta = max(1, num_sweeps // 1000)
+        num_betas = num_sweeps
+    else:
+        num_betas = max(1, num_sweeps // num_sweeps_per_beta)
 
     # set schedule to cxxjij
     schedule = cxxjij.utility.make_classical_schedule_list(
         beta_min=beta_min, beta_max=beta_max,
         one_mc_step=num_sweeps_per_beta,
-        num_call_updater=num_sweeps
+        num_call_updater=num_betas
     )
 
     return schedule, [beta_max, beta_min]
@@ -23,6 +23,8 @@ from dimod.core.sampler import samplemixinmethod
 import cimod
 
 import time
+import itertools
+import copy
 
 def measure_time(func):
     """Decorator for measuring calculation time.
@@ -67,7 +69,8 @@ class BaseSampler(dimod.Sampler):
     def _cxxjij_sampling(self, model, init_generator,
                          algorithm, system,
                          reinitialize_state=None,
-                         seed=None, structure=None):
+                         seed=None, structure=None,
+                         random_engine=None, postprocess=None):
         """Basic sampling function: for cxxjij sampling
 
         Args:
@@ -78,13 +81,32 @@ class BaseSampler(dimod.Sampler):
             reinitialize_state (bool, optional): [description]. Defaults to None.
             seed (int, optional): seed for algorithm. Defaults to None.
             structure (dict): structure dictionary that must have keys "size" and "dict"
+            random_engine (type, optional): random number engine class (e.g. cxxjij.utility.MT19937). Defaults to None (the default engine of cxxjij).
+            postprocess (callable, optional): run on the system after the algorithm at each read (e.g. cxxjij.algorithm.Algorithm_SteepestDescent_run). Defaults to None.
 
         Returns:
             :class:`openjij.sampler.response.Response`: results 
         """
 
         # set algorithm function and set random seed ----
-        if seed is None:
+        if random_engine is cxxjij.utility.Philox4x32 and seed is not None:
+            # the i-th read uses the i-th stream, so that the reads are independent but reproducible
+            read_index = itertools.count()
+            def sampling_algorithm(system):
+                engine = random_engine(seed, next(read_index))
+                return algorithm(system, engine, self._schedule)
+        elif random_engine is cxxjij.utility.Xoshiro256StarStar and seed is not None:
+            # the i-th read uses the master engine advanced by i jumps (non-overlapping substreams)
+            master_engine = random_engine(seed)
+            def sampling_algorithm(system):
+                engine = copy.copy(master_engine)
+                master_engine.jump()
+                return algorithm(system, engine, self._schedule)
+        elif random_engine is not None:
+            def sampling_algorithm(system):
+                engine = random_engine(seed) if seed is not None else random_engine()
+                return algorithm(system, engine, self._schedule)
+        elif seed is None:
             def sampling_algorithm(system):
                 return algorithm(system, self._schedule)
         else:
@@ -92,6 +114,13 @@ class BaseSampler(dimod.Sampler):
                 return algorithm(system, seed, self._schedule)
         # ---- set algorithm function and set random seed
 
+        if postprocess is not None:
+            _sampling_algorithm = sampling_algorithm
+            def sampling_algorithm(system):
+                result = _sampling_algorithm(system)
+                postprocess(system)
+                return result
+
         # setting of response class
         execution_time = []
 
@@ -157,6 +186,80 @@ class BaseSampler(dimod.Sampler):
 
         return response
 
+    @staticmethod
+    def _random_engine_class(random_engine):
+        """Get the cxxjij random number engine class from its name
+
+        Args:
+            random_engine (str): 'xorshift', 'mt19937', 'mt19937_64', 'philox4x32' or 'xoshiro256**'. None means the default engine.
+
+        Returns:
+            type: cxxjij.utility.Xorshift, cxxjij.utility.MT19937, cxxjij.utility.MT19937_64, cxxjij.utility.Philox4x32, cxxjij.utility.Xoshiro256StarStar or None
+        """
+        if random_engine is None:
+            return None
+        engines = {
+            'xorshift': cxxjij.utility.Xorshift,
+            'mt19937': cxxjij.utility.MT19937,
+            'mt1993764': cxxjij.utility.MT19937_64,
+            'philox4x32': cxxjij.utility.Philox4x32,
+            'xoshiro256**': cxxjij.utility.Xoshiro256StarStar,
+            'xoshiro256starstar': cxxjij.utility.Xoshiro256StarStar
+        }
+        _engine_name = random_engine.lower().replace('_', '').replace(' ', '')
+        if _engine_name not in engines:
+            raise ValueError('random_engine is one of "xorshift", "mt19937", "mt19937_64", "philox4x32" or "xoshiro256**"')
+        return engines[_engine_name]
+
+    @staticmethod
+    def _postprocess_algorithm(postprocess):
+        """Get the cxxjij post-processing algorithm from its name
+
+        Args:
+            postprocess (str): 'steepest descent' (flip the spin with the largest energy decrease until a 1-flip local minimum). None means no post-processing.
+
+        Returns:
+            callable: cxxjij.algorithm.Algorithm_SteepestDescent_run or None
+        """
+        if postprocess is None:
+            return None
+        algorithms = {
+            'steepestdescent': cxxjij.algorithm.Algorithm_SteepestDescent_run
+        }
+        _postprocess_name = postprocess.lower().replace('_', '').replace(' ', '')
+        if _postprocess_name not in algorithms:
+            raise ValueError('postprocess is "steepest descent" or None')
+        return algorithms[_postprocess_name]
+
+    @staticmethod
+    def _is_schedule_given(schedule):
+        """Checks if a non-empty schedule is given (schedule may be a list, a numpy array or a schedule generator)
+        """
+        return schedule is not None and len(schedule) > 0
+
+    def _time_budget_algorithm(self, algorithm, time_budget):
+        """Wrap an algorithm with time budget so that all the reads share the budget
+
+        Args:
+            algorithm (callable): cxxjij algorithm with time budget (e.g. Algorithm_SingleSpinFlip_run_with_time_budget)
+            time_budget (float): wall-clock time for all the reads in seconds
+
+        Returns:
+            callable: algorithm which takes the same arguments as the one without time budget
+        """
+        state = {'deadline': None, 'remaining_reads': self.num_reads}
+
+        def budgeted_algorithm(system, *args):
+            now = time.perf_counter()
+            if state['deadline'] is None:
+                state['deadline'] = now + time_budget
+            # the rest of the budget is divided equally among the remaining reads
+            budget = max(state['deadline'] - now, 0.0) / max(state['remaining_reads'], 1)
+            state['remaining_reads'] -= 1
+            return algorithm(system, *args, budget)
+
+        return budgeted_algorithm
+
     def _get_result(self, system, model):
         result = cxxjij.result.get_solution(system)
         sys_info = {}
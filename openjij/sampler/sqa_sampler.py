@@ -4,6 +4,14 @@ from openjij.sampler import measure_time
 from openjij.sampler import BaseSampler
 from openjij.utils.decorator import deprecated_alias
 import cxxjij
+
+_transverse_field_schedule_generators = (
+    cxxjij.utility.TransverseFieldLinearSchedule,
+    cxxjij.utility.TransverseFieldGeometricSchedule,
+    cxxjij.utility.TransverseFieldPowerSchedule,
+    cxxjij.utility.TransverseFieldPiecewiseLinearSchedule
+)
+
 class SQASampler(BaseSampler):
     """Sampler with Simulated Quantum Annealing (SQA).
 
@@ -60,52 +68,54 @@ class SQASampler(BaseSampler):
         }
 
         self._make_system = {
-            'singlespinflip': cxxjij.system.make_transverse_ising
+            'singlespinflip': cxxjij.system.make_transverse_ising,
+            'parallelsinglespinflip': cxxjij.system.make_transverse_ising,
+            'packedsinglespinflip': cxxjij.system.make_packed_transverse_ising
         }
         self._algorithm = {
-            'singlespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run
+            'singlespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run,
+            'parallelsinglespinflip': cxxjij.algorithm.Algorithm_ParallelSingleSpinFlip_run,
+            'packedsinglespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run
+        }
+        self._algorithm_with_time_budget = {
+            'singlespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run_with_time_budget,
+            'parallelsinglespinflip': cxxjij.algorithm.Algorithm_ParallelSingleSpinFlip_run_with_time_budget,
+            'packedsinglespinflip': cxxjij.algorithm.Algorithm_SingleSpinFlip_run_with_time_budget
         }
 
     def _convert_validation_schedule(self, schedule, beta):
-        if not isinstance(schedule, (list, np.array)):
+        # schedule generators are evaluated lazily in cxxjij
+        if isinstance(schedule, _transverse_field_schedule_generators):
+            return schedule
+
+        if not isinstance(schedule, (list, np.ndarray)):
             raise ValueError("schedule should be list or numpy.array")
 
         if isinstance(schedule[0], cxxjij.utility.TransverseFieldSchedule):
             return schedule
 
+        schedule = np.asarray(schedule)
+        if schedule.ndim != 2 or schedule.shape[1] not in (2, 3):
+            raise ValueError(
+                """schedule is list of tuple or list
+                (annealing parameter s : float, step_length : int) or
+                (annealing parameter s : float, beta: float, step_length : int)
+                """)
+
         # schedule validation  0 <= s <= 1
-        sch = np.array(schedule).T[0]
+        sch = schedule[:, 0]
         if not np.all((0 <= sch) & (sch <= 1)):
             raise ValueError("schedule range is '0 <= s <= 1'.")
 
-        if len(schedule[0]) == 2:
+        # convert to list of cxxjij.utility.TransverseFieldSchedule in one call
+        if schedule.shape[1] == 2:
             # schedule element: (s, one_mc_step) with beta fixed
-            # convert to list of cxxjij.utility.TransverseFieldSchedule
-            cxxjij_schedule = []
-            for s, one_mc_step in schedule:
-                _schedule = cxxjij.utility.TransverseFieldSchedule()
-                _schedule.one_mc_step = one_mc_step
-                _schedule.updater_parameter.beta = beta
-                _schedule.updater_parameter.s = s
-                cxxjij_schedule.append(_schedule)
-            return cxxjij_schedule
-        elif len(schedule[0]) == 3:
-            # schedule element: (s, beta, one_mc_step)
-            # convert to list of cxxjij.utility.TransverseFieldSchedule
-            cxxjij_schedule = []
-            for s, _beta, one_mc_step in schedule:
-                _schedule = cxxjij.utility.TransverseFieldSchedule()
-                _schedule.one_mc_step = one_mc_step
-                _schedule.updater_parameter.beta = _beta
-                _schedule.updater_parameter.s = s
-                cxxjij_schedule.append(_schedule)
-            return cxxjij_schedule
+            return cxxjij.utility.make_transverse_field_schedule_list_from_arrays(
+                beta, sch, schedule[:, 1].astype(np.uint64))
         else:
-            raise ValueError(
-                """schedule is list of tuple or list
-                (annealing parameter s : float, step_length : int) or
-                (annealing parameter s : float, beta: float, step_length : int)
-                """)
+            # schedule element: (s, beta, one_mc_step)
+            return cxxjij.utility.make_transverse_field_schedule_list_from_arrays(
+                schedule[:, 1], sch, schedule[:, 2].astype(np.uint64))
 
     def _get_result(self, system, model):
         state, info = super()._get_result(system, model)
@@ -123,7 +133,9 @@ class SQASampler(BaseSampler):
                      num_sweeps=None, schedule=None, trotter=None,
                      num_reads=1,
                      initial_state=None, updater='single spin flip',
-                     reinitialize_state=True, seed=None, structure=None):
+                     reinitialize_state=True, seed=None, structure=None,
+                     worldline_flip_ratio=0.0, time_budget=None,
+                     precision='float64', random_engine=None):
         """Sampling from the Ising model
 
         Args:
@@ -136,12 +148,16 @@ class SQASampler(BaseSampler):
             trotter (int): Trotter number.
             num_reads (int, optional): number of sampling. Defaults to 1.
             initial_state (list[int], optional): Initial state. Defaults to None.
-            updater (str, optional): update method. Defaults to 'single spin flip'.
+            updater (str, optional): update method, 'single spin flip', 'parallel single spin flip' (multi-threaded if built with USE_OMP) or 'packed single spin flip' (trotter spins packed into bits). Defaults to 'single spin flip'.
             reinitialize_state (bool, optional): Re-initilization at each sampling. Defaults to True.
             seed (int, optional): Sampling seed. Defaults to None.
             structure (dict): specify the structure. 
             This argument is necessary if the model has a specific structure (e.g. Chimera graph) and the updater algorithm is structure-dependent.
             structure must have two types of keys, namely "size" which shows the total size of spins and "dict" which is the map from model index (elements in model.indices) to the number.
+            worldline_flip_ratio (float, optional): number of worldline moves (flip a spin in all the trotter slices) per spin in each sweep. Only for 'single spin flip' and 'parallel single spin flip'. Defaults to 0.0.
+            time_budget (float, optional): wall-clock time for all the reads in seconds. If given, the schedule is stretched or compressed to finish on time. Defaults to None.
+            precision (str, optional): floating point precision of the interactions, 'float64' or 'float32'. Defaults to 'float64'.
+            random_engine (str, optional): random number engine, 'xorshift', 'mt19937', 'mt19937_64', 'philox4x32' (the i-th read uses the i-th stream) or 'xoshiro256**' (the i-th read uses the i-th jump). Defaults to None (the default engine).
 
         Raises:
             ValueError: 
@@ -172,15 +188,22 @@ class SQASampler(BaseSampler):
                      num_sweeps=num_sweeps, schedule=schedule, trotter=trotter,
                      num_reads=num_reads,
                      initial_state=initial_state, updater=updater,
-                     reinitialize_state=reinitialize_state, seed=seed, structure=structure)
+                     reinitialize_state=reinitialize_state, seed=seed, structure=structure,
+                     worldline_flip_ratio=worldline_flip_ratio, time_budget=time_budget,
+                     precision=precision, random_engine=random_engine)
 
     def _sampling(self, bqm, beta=None, gamma=None,
                      num_sweeps=None, schedule=None, trotter=None,
                      num_reads=1,
                      initial_state=None, updater='single spin flip',
-                     reinitialize_state=True, seed=None, structure=None):
+                     reinitialize_state=True, seed=None, structure=None,
+                     worldline_flip_ratio=0.0, time_budget=None,
+                     precision='float64', random_engine=None):
 
-        ising_graph = bqm.get_cxxjij_ising_graph()
+        # packed trotter spins only support sparse ising graph
+        _packed = updater.lower().replace('_', '').replace(' ', '') == 'packedsinglespinflip'
+        ising_graph = bqm.get_cxxjij_ising_graph(sparse=_packed, precision=precision)
+        _random_engine = self._random_engine_class(random_engine)
 
         self._setting_overwrite(
             beta=beta, gamma=gamma,
@@ -224,20 +247,32 @@ class SQASampler(BaseSampler):
         # choose updater -------------------------------------------
         _updater_name = updater.lower().replace('_', '').replace(' ', '')
         if _updater_name not in self._algorithm:
-            raise ValueError('updater is one of "single spin flip"')
+            raise ValueError('updater is one of "single spin flip", "parallel single spin flip", "packed single spin flip"')
         algorithm = self._algorithm[_updater_name] 
+        if time_budget is not None:
+            if _random_engine is not None:
+                raise ValueError('time_budget cannot be used with random_engine')
+            algorithm = self._time_budget_algorithm(
+                self._algorithm_with_time_budget[_updater_name], time_budget)
         sqa_system = self._make_system[_updater_name](
             init_generator(), ising_graph, self.gamma
         )
+        if worldline_flip_ratio > 0:
+            if _updater_name not in ('singlespinflip', 'parallelsinglespinflip'):
+                raise ValueError('worldline_flip_ratio is only supported by "single spin flip" and "parallel single spin flip"')
+            sqa_system.worldline_flip_ratio = worldline_flip_ratio
         # ------------------------------------------- choose updater
 
         response = self._cxxjij_sampling(
             bqm, init_generator,
             algorithm, sqa_system,
-            reinitialize_state, seed, structure
+            reinitialize_state, seed, structure,
+            random_engine=_random_engine
         )
 
         response.info['schedule'] = self.schedule_info
+        if time_budget is not None:
+            response.info['time_budget'] = time_budget
 
         return response
 
@@ -247,9 +282,9 @@ class SQASampler(BaseSampler):
                                     schedule=None):
         self.beta = beta if beta else self.beta
         self.gamma = gamma if gamma else self.gamma
-        if schedule or self.schedule:
+        if self._is_schedule_given(schedule) or self._is_schedule_given(self.schedule):
             self._schedule = self._convert_validation_schedule(
-                schedule if schedule else self.schedule, self.beta
+                schedule if self._is_schedule_given(schedule) else self.schedule, self.beta
             )
             self.schedule_info = {'schedule': 'custom schedule'}
         else:
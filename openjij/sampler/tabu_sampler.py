@@ -0,0 +1,190 @@
+# Copyright 2019 Jij Inc.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License
+
+import numpy as np
+import openjij
+from openjij.sampler import BaseSampler
+import cxxjij
+
+"""
+This module contains Tabu Search sampler.
+"""
+
+
+class TabuSampler(BaseSampler):
+    """Sampler with Tabu Search.
+
+    Each read starts from a random (or given) state and flips the spin with the lowest energy difference among the spins which are not tabu.
+    The returned state is the lowest-energy state found in the read.
+
+    Args:
+        num_iterations (int):
+            maximum number of single spin flips in each run.
+            You can overwrite in methods .sample_*.
+
+        tenure (int):
+            number of moves during which a flipped spin cannot be flipped back.
+            0 means min(20, num_spins/4) + 1.
+            You can overwrite in methods .sample_*.
+
+        num_restarts (int):
+            number of restarts from the best state (partially randomized) in each read.
+            You can overwrite in methods .sample_*.
+
+        max_stagnation (int):
+            a run is finished if the best energy is not improved for this number of moves (0: disabled).
+            You can overwrite in methods .sample_*.
+
+        num_reads (int):
+            number of sampling (algorithm) runs. defaults 1.
+            You can overwrite in methods .sample_*.
+
+    """
+
+    @property
+    def parameters(self):
+        return {
+            'num_iterations': ['parameters'],
+            'tenure': ['parameters'],
+            'num_restarts': ['parameters'],
+        }
+
+    def __init__(self,
+                 num_iterations=10000, tenure=0,
+                 num_restarts=10, max_stagnation=1000,
+                 num_reads=1):
+
+        self.num_iterations = num_iterations
+        self.tenure = tenure
+        self.num_restarts = num_restarts
+        self.max_stagnation = max_stagnation
+        self.num_reads = num_reads
+        self._schedule_setting = {
+            'num_iterations': num_iterations,
+            'tenure': tenure,
+            'num_restarts': num_restarts,
+            'max_stagnation': max_stagnation,
+            'num_reads': num_reads,
+        }
+
+    def sample_ising(self, h, J, num_iterations=None, tenure=None,
+                     num_restarts=None, max_stagnation=None, num_reads=1,
+                     initial_state=None, reinitialize_state=True, seed=None,
+                     sparse=False, precision='float64'):
+        """sample Ising model.
+
+        Args:
+            h (dict): linear biases
+            J (dict): quadratic biases
+            num_iterations (int): maximum number of single spin flips in each run
+            tenure (int): tabu tenure (0: min(20, num_spins/4) + 1)
+            num_restarts (int): number of restarts in each read
+            max_stagnation (int): a run is finished if the best energy is not improved for this number of moves (0: disabled)
+            num_reads (int): number of reads
+            initial_state (dict): initial state
+            reinitialize_state (bool): if true reinitialize state for each read
+            seed (int): seed for tabu search
+            sparse (bool): if true use sparse interactions (a move costs O((degree + tenure) log num_spins) instead of O(num_spins))
+            precision (str): floating point precision of the interactions, 'float64' or 'float32'
+        Returns:
+            :class:`openjij.sampler.response.Response`: results
+
+        Examples:
+
+            for Ising case::
+
+                >>> h = {0: -1, 1: -1, 2: 1, 3: 1}
+                >>> J = {(0, 1): -1, (3, 4): -1}
+                >>> sampler = oj.TabuSampler()
+                >>> res = sampler.sample_ising(h, J)
+
+            for QUBO case::
+
+                >>> Q = {(0, 0): -1, (1, 1): -1, (2, 2): 1, (3, 3): 1, (4, 4): 1, (0, 1): -1, (3, 4): 1}
+                >>> sampler = oj.TabuSampler()
+                >>> res = sampler.sample_qubo(Q)
+
+        """
+
+        model = openjij.BinaryQuadraticModel(
+            linear=h, quadratic=J, var_type='SPIN'
+        )
+        return self._sampling(model, num_iterations, tenure,
+                              num_restarts, max_stagnation, num_reads,
+                              initial_state, reinitialize_state, seed,
+                              sparse=sparse, precision=precision)
+
+    def _sampling(self, model, num_iterations=None, tenure=None,
+                  num_restarts=None, max_stagnation=None, num_reads=1,
+                  initial_state=None, reinitialize_state=True, seed=None,
+                  sparse=False, precision='float64'):
+        """sampling by using specified model
+        Args:
+            model (openjij.BinaryQuadraticModel): BinaryQuadraticModel
+            num_iterations (int): maximum number of single spin flips in each run
+            tenure (int): tabu tenure (0: min(20, num_spins/4) + 1)
+            num_restarts (int): number of restarts in each read
+            max_stagnation (int): a run is finished if the best energy is not improved for this number of moves (0: disabled)
+            num_reads (int): number of reads
+            initial_state (dict): initial state
+            reinitialize_state (bool): if true reinitialize state for each read
+            seed (int): seed for tabu search
+            sparse (bool): if true use sparse interactions
+            precision (str): floating point precision of the interactions, 'float64' or 'float32'
+        Returns:
+            :class:`openjij.sampler.response.Response`: results
+        """
+        ising_graph = model.get_cxxjij_ising_graph(sparse=sparse, precision=precision)
+
+        self._setting_overwrite(
+            num_iterations=num_iterations, tenure=tenure,
+            num_restarts=num_restarts, max_stagnation=max_stagnation,
+            num_reads=num_reads
+        )
+
+        # parameters of tabu search are passed in place of a schedule
+        self._schedule = cxxjij.algorithm.TabuSearchParameter(
+            num_iterations=self._schedule_setting['num_iterations'],
+            tenure=self._schedule_setting['tenure'],
+            num_restarts=self._schedule_setting['num_restarts'],
+            max_stagnation=self._schedule_setting['max_stagnation']
+        )
+
+        # make init state generator --------------------------------
+        if initial_state is None:
+            def _generate_init_state(): return ising_graph.gen_spin(seed) if seed != None else ising_graph.gen_spin()
+        else:
+            if isinstance(initial_state, dict):
+                initial_state = [initial_state[k] for k in model.indices]
+            if len(initial_state) != ising_graph.size():
+                raise ValueError(
+                    "the size of the initial state should be {}"
+                    .format(ising_graph.size()))
+            _init_state = np.array(initial_state)
+
+            def _generate_init_state(): return np.array(_init_state)
+        # -------------------------------- make init state generator
+
+        tabu_system = cxxjij.system.make_classical_ising(_generate_init_state(), ising_graph)
+        response = self._cxxjij_sampling(
+            model, _generate_init_state,
+            cxxjij.algorithm.Algorithm_TabuSearch_run, tabu_system,
+            reinitialize_state, seed
+        )
+
+        response.info['parameters'] = {
+            key: self._schedule_setting[key]
+            for key in ('num_iterations', 'tenure', 'num_restarts', 'max_stagnation')
+        }
+
+        return response
@@ -0,0 +1,168 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_ALGORITHM_ADAPTIVE_SCHEDULE_HPP__
+#define OPENJIJ_ALGORITHM_ADAPTIVE_SCHEDULE_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <system/system.hpp>
+#include <utility/schedule_list.hpp>
+
+namespace openjij {
+    namespace algorithm {
+
+        /**
+         * @brief adaptive annealing schedule for classical systems.
+         * beta is not given in advance but controlled so that the measured acceptance ratio follows a target curve.
+         *
+         * @details the sweeps are done in blocks. after each block, beta is multiplied by log(target)/log(acceptance),
+         * which is the exact correction if the acceptance ratio behaves as exp(-beta dE) with a typical dE.
+         * the factor is clamped to [1/max_beta_factor, max_beta_factor].
+         *
+         * the run has two phases:
+         * - warm-up: beta is moved in both directions (i.e. the system is heated up if beta is too large)
+         *   until the acceptance ratio gets close to initial_acceptance.
+         * - annealing: the target decreases geometrically from initial_acceptance to final_acceptance over the rest of the sweeps,
+         *   and beta is only increased.
+         *
+         * the run is stopped early if no flip is accepted for max_frozen_blocks consecutive blocks.
+         */
+        struct AdaptiveSchedule {
+
+            /**
+             * @brief maximum number of sweeps (including the warm-up)
+             */
+            std::size_t num_sweeps = 1000;
+
+            /**
+             * @brief number of sweeps in a block, over which the acceptance ratio is measured
+             */
+            std::size_t sweeps_per_block = 10;
+
+            /**
+             * @brief beta at the beginning of the warm-up
+             */
+            double initial_beta = 1.0;
+
+            /**
+             * @brief target acceptance ratio at the beginning of the annealing
+             */
+            double initial_acceptance = 0.5;
+
+            /**
+             * @brief target acceptance ratio at the end of the annealing
+             */
+            double final_acceptance = 0.001;
+
+            /**
+             * @brief the warm-up ends if the acceptance ratio is within initial_acceptance * (1 +- warmup_tolerance)
+             */
+            double warmup_tolerance = 0.2;
+
+            /**
+             * @brief maximum number of blocks in the warm-up
+             */
+            std::size_t max_warmup_blocks = 20;
+
+            /**
+             * @brief maximum factor by which beta is changed after a block
+             */
+            double max_beta_factor = 2.0;
+
+            /**
+             * @brief stop if no flip is accepted for this number of consecutive blocks in the annealing (0: disabled)
+             */
+            std::size_t max_frozen_blocks = 5;
+
+            /**
+             * @brief check the parameters
+             *
+             * @throw std::invalid_argument if a parameter is out of range
+             */
+            void validate() const {
+                if(sweeps_per_block == 0) {
+                    throw std::invalid_argument("sweeps_per_block must be positive");
+                }
+                if(!(initial_beta > 0)) {
+                    throw std::invalid_argument("initial_beta must be positive");
+                }
+                if(!(0 < final_acceptance && final_acceptance <= initial_acceptance && initial_acceptance < 1)) {
+                    throw std::invalid_argument("acceptance ratios must satisfy 0 < final_acceptance <= initial_acceptance < 1");
+                }
+                if(!(max_beta_factor > 1)) {
+                    throw std::invalid_argument("max_beta_factor must be greater than 1");
+                }
+            }
+
+            /**
+             * @brief target acceptance ratio at the given progress of the annealing
+             *
+             * @param progress from 0 (beginning) to 1 (end)
+             */
+            double target_acceptance(double progress) const {
+                return initial_acceptance * std::pow(final_acceptance / initial_acceptance, progress);
+            }
+
+            /**
+             * @brief factor by which beta should be multiplied to move the acceptance ratio to the target
+             *
+             * @param acceptance measured acceptance ratio (in (0, 1))
+             * @param target target acceptance ratio (in (0, 1))
+             */
+            double beta_factor(double acceptance, double target) const {
+                const double factor = std::log(target) / std::log(acceptance);
+                return std::min(std::max(factor, 1.0 / max_beta_factor), max_beta_factor);
+            }
+        };
+
+        /**
+         * @brief report of an annealing run with an adaptive schedule
+         */
+        struct AdaptiveScheduleReport {
+
+            /**
+             * @brief the schedule actually used (beta and number of sweeps of each block)
+             */
+            utility::ClassicalScheduleList schedule_list;
+
+            /**
+             * @brief measured acceptance ratio of each block
+             */
+            std::vector<double> acceptance_ratio;
+
+            /**
+             * @brief number of blocks in the warm-up
+             */
+            std::size_t num_warmup_blocks = 0;
+
+            /**
+             * @brief number of sweeps done
+             */
+            std::size_t num_sweeps = 0;
+
+            /**
+             * @brief true if the run is stopped since the system is frozen
+             */
+            bool frozen = false;
+        };
+
+    } // namespace algorithm
+} // namespace openjij
+
+#endif
@@ -15,8 +15,19 @@
 #ifndef SYSTEM_ALGORITHM_ALGORITHM_HPP__
 #define SYSTEM_ALGORITHM_ALGORITHM_HPP__
 
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <algorithm/adaptive_schedule.hpp>
+#include <algorithm/stopping_criteria.hpp>
 #include <system/system.hpp>
+#include <utility/random.hpp>
+#include <utility/schedule_generator.hpp>
 #include <utility/schedule_list.hpp>
 
 namespace openjij {
@@ -46,6 +57,357 @@ namespace openjij {
                     }
                 }
             }
+
+            /**
+             * @brief run with a schedule generator, which gives each schedule on the fly instead of a stored schedule list
+             *
+             * @param system
+             * @param random_number_engine
+             * @param schedule_generator schedule generator (e.g. utility::ScheduleGenerator)
+             * @param callback
+             */
+            template<typename System, typename RandomNumberEngine, typename ScheduleGenerator,
+                typename std::enable_if<utility::is_schedule_generator<ScheduleGenerator>::value, std::nullptr_t>::type = nullptr>
+            static void run(System& system,
+                            RandomNumberEngine& random_number_engine,
+                            const ScheduleGenerator& schedule_generator,
+                            const std::function<void(const System&, const utility::UpdaterParameter<typename system::get_system_type<System>::type>&)>& callback = nullptr) {
+                static_assert(std::is_same<typename ScheduleGenerator::system_type, typename system::get_system_type<System>::type>::value,
+                        "system type of the schedule generator does not match");
+                const std::size_t num_schedules = schedule_generator.size();
+                for (std::size_t index = 0; index < num_schedules; ++index) {
+                    const auto schedule = schedule_generator[index];
+                    for (std::size_t i = 0; i < schedule.one_mc_step; ++i) {
+                        Updater<System>::update(system, random_number_engine, schedule.updater_parameter);
+                        if (callback) {
+                            callback(system, schedule.updater_parameter);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief run with an observer called after every interval Monte Carlo steps
+             *
+             * @details unlike the std::function callback, the observer is a template parameter and can be inlined.
+             * if interval is once_per_schedule (0), the observer is called once at the end of each schedule.
+             *
+             * @param system
+             * @param random_number_engine
+             * @param schedule_list
+             * @param observer functor called as observer(system, updater_parameter)
+             * @param interval number of Monte Carlo steps between observer calls (counted through the whole schedule list)
+             */
+            template<typename System, typename RandomNumberEngine, typename Observer>
+            static void run(System& system,
+                            RandomNumberEngine& random_number_engine,
+                            const utility::ScheduleList<typename system::get_system_type<System>::type>& schedule_list,
+                            Observer&& observer,
+                            std::size_t interval) {
+                std::size_t step = 0;
+                for (auto&& schedule : schedule_list) {
+                    for (std::size_t i = 0; i < schedule.one_mc_step; ++i) {
+                        Updater<System>::update(system, random_number_engine, schedule.updater_parameter);
+                        if (interval != once_per_schedule && ++step % interval == 0) {
+                            observer(static_cast<const System&>(system), schedule.updater_parameter);
+                        }
+                    }
+                    if (interval == once_per_schedule && schedule.one_mc_step > 0) {
+                        observer(static_cast<const System&>(system), schedule.updater_parameter);
+                    }
+                }
+            }
+
+            /**
+             * @brief run until all the schedules are done or one of the stopping criteria fires
+             *
+             * @details the system must have observables (e.g. ClassicalIsing).
+             * the criteria on energy and acceptance are checked after every Monte Carlo step,
+             * and the criterion on the best energy at the end of every schedule.
+             *
+             * @param system
+             * @param random_number_engine
+             * @param schedule_list
+             * @param criteria stopping criteria
+             *
+             * @return which criterion fired and when
+             */
+            template<typename System, typename RandomNumberEngine>
+            static RunReport run(System& system,
+                                 RandomNumberEngine& random_number_engine,
+                                 const utility::ScheduleList<typename system::get_system_type<System>::type>& schedule_list,
+                                 const StoppingCriteria& criteria) {
+                RunReport report;
+                const auto& observables = system.observables;
+                std::size_t steps_without_acceptance = 0;
+                std::size_t schedules_without_improvement = 0;
+                auto best_energy = observables.best_energy;
+
+                for (report.schedule_index = 0; report.schedule_index < schedule_list.size(); ++report.schedule_index) {
+                    const auto& schedule = schedule_list[report.schedule_index];
+                    for (std::size_t i = 0; i < schedule.one_mc_step; ++i) {
+                        const auto num_accepted = observables.num_accepted;
+                        Updater<System>::update(system, random_number_engine, schedule.updater_parameter);
+                        ++report.num_steps;
+
+                        if (observables.energy <= criteria.target_energy) {
+                            report.reason = StopReason::target_energy;
+                            return report;
+                        }
+
+                        steps_without_acceptance = (observables.num_accepted == num_accepted) ? steps_without_acceptance+1 : 0;
+                        if (criteria.max_steps_without_acceptance != 0 && steps_without_acceptance >= criteria.max_steps_without_acceptance) {
+                            report.reason = StopReason::no_acceptance;
+                            return report;
+                        }
+                    }
+
+                    schedules_without_improvement = (observables.best_energy < best_energy) ? 0 : schedules_without_improvement+1;
+                    best_energy = observables.best_energy;
+                    if (criteria.max_schedules_without_improvement != 0 && schedules_without_improvement >= criteria.max_schedules_without_improvement) {
+                        report.reason = StopReason::no_improvement;
+                        return report;
+                    }
+                }
+
+                report.reason = StopReason::completed;
+                return report;
+            }
+
+            /**
+             * @brief run with an adaptive schedule, in which beta follows the measured acceptance ratio
+             *
+             * @details the system must be a classical system with observables (e.g. ClassicalIsing),
+             * and the updater must report each trial to the observables (e.g. SingleSpinFlip).
+             *
+             * @param system
+             * @param random_number_engine
+             * @param schedule adaptive schedule
+             *
+             * @return the schedule actually used and the measured acceptance ratios
+             */
+            template<typename System, typename RandomNumberEngine>
+            static AdaptiveScheduleReport run(System& system,
+                                              RandomNumberEngine& random_number_engine,
+                                              const AdaptiveSchedule& schedule) {
+                static_assert(std::is_same<typename system::get_system_type<System>::type, system::classical_system>::value,
+                        "adaptive schedule is only for classical systems");
+                schedule.validate();
+
+                AdaptiveScheduleReport report;
+                const auto& observables = system.observables;
+                double beta = schedule.initial_beta;
+                bool warming_up = schedule.max_warmup_blocks > 0;
+                std::size_t annealing_start = 0;
+                std::size_t frozen_blocks = 0;
+
+                while (report.num_sweeps < schedule.num_sweeps) {
+                    const std::size_t sweeps = std::min(schedule.sweeps_per_block, schedule.num_sweeps - report.num_sweeps);
+                    const utility::ClassicalUpdaterParameter parameter(beta);
+                    const auto num_accepted = observables.num_accepted;
+                    const auto num_rejected = observables.num_rejected;
+                    for (std::size_t i = 0; i < sweeps; ++i) {
+                        Updater<System>::update(system, random_number_engine, parameter);
+                    }
+                    report.num_sweeps += sweeps;
+                    report.schedule_list.emplace_back(std::make_pair(parameter, sweeps));
+
+                    const std::size_t accepted = observables.num_accepted - num_accepted;
+                    const std::size_t trials = accepted + (observables.num_rejected - num_rejected);
+                    report.acceptance_ratio.push_back((trials == 0) ? 0.0 : static_cast<double>(accepted) / trials);
+                    // regularized so that the logarithm is finite
+                    const double acceptance = (accepted + 0.5) / (trials + 1.0);
+
+                    if (warming_up) {
+                        // beta can be decreased, i.e. the system is heated up if it is too cold
+                        const double target = schedule.initial_acceptance;
+                        ++report.num_warmup_blocks;
+                        if (std::abs(acceptance - target) <= schedule.warmup_tolerance * target
+                                || report.num_warmup_blocks >= schedule.max_warmup_blocks) {
+                            warming_up = false;
+                            annealing_start = report.num_sweeps;
+                        }
+                        beta *= schedule.beta_factor(acceptance, target);
+                        continue;
+                    }
+
+                    frozen_blocks = (accepted == 0) ? frozen_blocks+1 : 0;
+                    if (schedule.max_frozen_blocks != 0 && frozen_blocks >= schedule.max_frozen_blocks) {
+                        report.frozen = true;
+                        break;
+                    }
+
+                    const double progress = static_cast<double>(report.num_sweeps - annealing_start) / (schedule.num_sweeps - annealing_start);
+                    beta *= std::max(1.0, schedule.beta_factor(acceptance, schedule.target_acceptance(progress)));
+                }
+
+                return report;
+            }
+
+            /**
+             * @brief run within the given wall-clock time, stretching or compressing the schedule list
+             *
+             * @details the schedule list gives the shape of the schedule: the number of Monte Carlo steps of each schedule
+             * is scaled so that the whole list finishes at the deadline.
+             * the throughput is measured by a warm-up within the share of the first schedule (the warm-up steps are a part of it),
+             * and it is measured again after each schedule to project the number of steps of the whole run,
+             * which is split as the schedule list (so that the warm-up steps are counted once).
+             *
+             * @param system
+             * @param random_number_engine
+             * @param schedule_list shape of the schedule (the ratios of one_mc_step are kept)
+             * @param time_budget wall-clock time for this run
+             * @param clock clock measuring the time with Clock::now() (std::chrono::steady_clock by default)
+             *
+             * @return number of Monte Carlo steps done
+             */
+            template<typename System, typename RandomNumberEngine, typename Rep, typename Period, typename Clock = std::chrono::steady_clock>
+            static std::size_t run(System& system,
+                                   RandomNumberEngine& random_number_engine,
+                                   const utility::ScheduleList<typename system::get_system_type<System>::type>& schedule_list,
+                                   std::chrono::duration<Rep, Period> time_budget,
+                                   Clock clock = Clock()) {
+                using Seconds = std::chrono::duration<double>;
+
+                const auto start = clock.now();
+                const double budget = std::chrono::duration_cast<Seconds>(time_budget).count();
+
+                double total_weight = 0;
+                for (auto&& schedule : schedule_list) {
+                    total_weight += schedule.one_mc_step;
+                }
+                if (schedule_list.empty() || total_weight == 0 || budget <= 0) {
+                    return 0;
+                }
+
+                // warm-up: double the number of steps until it takes warmup_fraction of the share of the first schedule
+                const double warmup_time = warmup_fraction * budget * (schedule_list.front().one_mc_step / total_weight);
+                std::size_t num_steps = 0;
+                double elapsed = 0;
+                for (std::size_t batch = 1; num_steps == 0 || elapsed <= warmup_time; batch *= 2) {
+                    for (std::size_t i = 0; i < batch; ++i) {
+                        Updater<System>::update(system, random_number_engine, schedule_list.front().updater_parameter);
+                    }
+                    num_steps += batch;
+                    elapsed = Seconds(clock.now() - start).count();
+                }
+
+                // throughput of the latest steps (the warm-up at first)
+                double throughput = num_steps / elapsed;
+                double cumulative_weight = 0;
+                for (auto&& schedule : schedule_list) {
+                    // the end of this schedule in the whole run, projected with the remaining time
+                    cumulative_weight += schedule.one_mc_step;
+                    const double total_steps = num_steps + std::max(0.0, budget - elapsed) * throughput;
+                    const auto end = static_cast<std::size_t>(std::llround(total_steps * (cumulative_weight / total_weight)));
+                    const std::size_t steps = (end > num_steps) ? end - num_steps : 0;
+
+                    for (std::size_t i = 0; i < steps; ++i) {
+                        Updater<System>::update(system, random_number_engine, schedule.updater_parameter);
+                    }
+                    num_steps += steps;
+
+                    const double previous_elapsed = elapsed;
+                    elapsed = Seconds(clock.now() - start).count();
+                    if (steps > 0 && elapsed > previous_elapsed) {
+                        throughput = steps / (elapsed - previous_elapsed);
+                    }
+                }
+
+                return num_steps;
+            }
+
+            /**
+             * @brief run from the given position in the schedule list for at most max_steps Monte Carlo steps
+             *
+             * @details position is advanced, so that the run can be continued (e.g. after saving a checkpoint)
+             * by calling this function again. the run is finished if position.schedule_index reaches the size of the schedule list.
+             *
+             * @param system
+             * @param random_number_engine
+             * @param schedule_list
+             * @param position position in the schedule list (updated)
+             * @param max_steps maximum number of Monte Carlo steps in this call
+             *
+             * @return number of Monte Carlo steps done
+             */
+            template<typename System, typename RandomNumberEngine>
+            static std::size_t run_from(System& system,
+                                        RandomNumberEngine& random_number_engine,
+                                        const utility::ScheduleList<typename system::get_system_type<System>::type>& schedule_list,
+                                        utility::SchedulePosition& position,
+                                        std::size_t max_steps = std::numeric_limits<std::size_t>::max()) {
+                std::size_t num_steps = 0;
+                while (position.schedule_index < schedule_list.size()) {
+                    const auto& schedule = schedule_list[position.schedule_index];
+                    for (; position.step < schedule.one_mc_step; ++position.step) {
+                        if (num_steps == max_steps) {
+                            return num_steps;
+                        }
+                        Updater<System>::update(system, random_number_engine, schedule.updater_parameter);
+                        ++num_steps;
+                    }
+                    ++position.schedule_index;
+                    position.step = 0;
+                }
+                return num_steps;
+            }
+
+            /**
+             * @brief run independent replicas in parallel
+             *
+             * @details replica i is updated with stream i of utility::Philox4x32 keyed by seed,
+             * so that the result is bit-identical regardless of the number of threads and the scheduling.
+             *
+             * @param systems replicas
+             * @param seed seed shared by all the replicas
+             * @param schedule_list
+             */
+            template<typename System>
+            static void run_replicas(std::vector<System>& systems,
+                                     std::uint64_t seed,
+                                     const utility::ScheduleList<typename system::get_system_type<System>::type>& schedule_list) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+                for (std::size_t replica = 0; replica < systems.size(); ++replica) {
+                    auto random_number_engine = utility::Philox4x32(seed, replica);
+                    run(systems[replica], random_number_engine, schedule_list);
+                }
+            }
+
+            /**
+             * @brief run independent replicas in parallel with the substreams of a master engine
+             *
+             * @details replica i is updated with the master engine advanced by i jumps (see utility::make_substreams).
+             *
+             * @param systems replicas
+             * @param random_number_engine master engine with jump() (e.g. utility::Xoshiro256StarStar)
+             * @param schedule_list
+             */
+            template<typename System, typename RandomNumberEngine,
+                     std::enable_if_t<utility::has_jump<RandomNumberEngine>::value, std::nullptr_t> = nullptr>
+            static void run_replicas(std::vector<System>& systems,
+                                     const RandomNumberEngine& random_number_engine,
+                                     const utility::ScheduleList<typename system::get_system_type<System>::type>& schedule_list) {
+                auto engines = utility::make_substreams(random_number_engine, systems.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+                for (std::size_t replica = 0; replica < systems.size(); ++replica) {
+                    run(systems[replica], engines[replica], schedule_list);
+                }
+            }
+
+            /**
+             * @brief fraction of the time budget used to measure the throughput
+             */
+            static constexpr double warmup_fraction = 0.01;
+
+            /**
+             * @brief observer interval for calling the observer once at the end of each schedule
+             */
+            static constexpr std::size_t once_per_schedule = 0;
         };
 
         //type alias (Monte Carlo method)
@@ -16,5 +16,9 @@
 #define OPENJIJ_ALGORITHM_ALL_HPP__
 
 #include <algorithm/algorithm.hpp>
+#include <algorithm/adaptive_schedule.hpp>
+#include <algorithm/stopping_criteria.hpp>
+#include <algorithm/tabu_search.hpp>
+#include <algorithm/steepest_descent.hpp>
 
 #endif
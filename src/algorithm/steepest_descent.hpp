@@ -0,0 +1,127 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_ALGORITHM_STEEPEST_DESCENT_HPP__
+#define OPENJIJ_ALGORITHM_STEEPEST_DESCENT_HPP__
+
+#include <cstddef>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include <system/classical_ising.hpp>
+
+namespace openjij {
+    namespace algorithm {
+
+        /**
+         * @brief steepest descent to a 1-flip local minimum for classical ising systems
+         *
+         * @details the spin with the largest energy decrease is flipped until no single flip decreases the energy.
+         * the candidates (spins with dE < 0) are kept in a max-heap keyed by -dE.
+         * the heap is lazy: after a flip, the changed spins are pushed again with a new version and outdated entries are dropped when popped.
+         * thus a move costs O(degree log num_spins) for sparse interactions (O(num_spins log num_spins) for dense ones).
+         * the energy differences are read from the local fields of ClassicalIsing::workspace.
+         */
+        struct SteepestDescent {
+
+            /**
+             * @brief run steepest descent from the current spins of the system
+             *
+             * @param system classical ising system (Dense or Sparse). the system is left in a 1-flip local minimum
+             *
+             * @return number of flips
+             */
+            template<typename GraphType>
+            static std::size_t run(system::ClassicalIsing<GraphType>& system) {
+                const std::size_t num_spins = system.num_spins;
+
+                system.fix_gauge();
+                system.synchronize_local_field();
+
+                // (energy decrease, index, version)
+                using Entry = std::tuple<double, std::size_t, std::size_t>;
+                std::priority_queue<Entry> heap;
+                std::vector<std::size_t> version(num_spins, 0);
+
+                const auto push = [&](std::size_t i) {
+                    ++version[i];
+                    const double dE = system.delta_energy(i);
+                    if (dE < 0) {
+                        heap.emplace(-dE, i, version[i]);
+                    }
+                };
+
+                for (std::size_t i = 0; i < num_spins; ++i) {
+                    push(i);
+                }
+
+                std::size_t num_flips = 0;
+                while (!heap.empty()) {
+                    const std::size_t index = std::get<1>(heap.top());
+                    const std::size_t entry_version = std::get<2>(heap.top());
+                    heap.pop();
+                    if (entry_version != version[index]) {
+                        continue;
+                    }
+                    system.flip_with_local_field(index);
+                    ++num_flips;
+                    push(index);
+                    for_each_neighbor(system, index, push);
+
+                    // drop the outdated entries if the heap gets too large (dense interactions)
+                    if (heap.size() > 4 * num_spins + 16) {
+                        heap = std::priority_queue<Entry>();
+                        for (std::size_t i = 0; i < num_spins; ++i) {
+                            push(i);
+                        }
+                    }
+                }
+
+                return num_flips;
+            }
+
+        private:
+
+            /**
+             * @brief call func for the spins whose local field is changed by flipping ith spin (dense interactions)
+             */
+            template<typename FloatType, typename Function>
+            static void for_each_neighbor(const system::ClassicalIsing<graph::Dense<FloatType>>& system, std::size_t index, Function&& func) {
+                for (std::size_t j = 0; j < system.num_spins; ++j) {
+                    if (j != index && system.interaction(index, j) != 0) {
+                        func(j);
+                    }
+                }
+            }
+
+            /**
+             * @brief call func for the spins whose local field is changed by flipping ith spin (sparse interactions)
+             */
+            template<typename FloatType, typename Function>
+            static void for_each_neighbor(const system::ClassicalIsing<graph::Sparse<FloatType>>& system, std::size_t index, Function&& func) {
+                using SparseMatrixXx = typename system::ClassicalIsing<graph::Sparse<FloatType>>::SparseMatrixXx;
+                for (typename SparseMatrixXx::InnerIterator it(system.interaction, index); it; ++it) {
+                    const std::size_t j = it.index();
+                    if (j < system.num_spins && j != index) {
+                        func(j);
+                    }
+                }
+            }
+        };
+
+    } // namespace algorithm
+} // namespace openjij
+
+#endif
@@ -0,0 +1,81 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_ALGORITHM_STOPPING_CRITERIA_HPP__
+#define OPENJIJ_ALGORITHM_STOPPING_CRITERIA_HPP__
+
+#include <cstddef>
+#include <limits>
+
+namespace openjij {
+    namespace algorithm {
+
+        /**
+         * @brief criteria for stopping an annealing run early.
+         * the criteria are evaluated with the observables of the system (e.g. ClassicalIsing::observables).
+         */
+        struct StoppingCriteria {
+
+            /**
+             * @brief stop if no flip is accepted for this number of consecutive Monte Carlo steps (0: disabled).
+             * SwendsenWang counts a flipped cluster as an accepted flip, thus it stops when the system is frozen into a single cluster.
+             */
+            std::size_t max_steps_without_acceptance = 0;
+
+            /**
+             * @brief stop if the energy gets equal to or lower than this value (disabled by default)
+             */
+            double target_energy = std::numeric_limits<double>::lowest();
+
+            /**
+             * @brief stop if the best energy is not improved for this number of consecutive schedules (0: disabled)
+             */
+            std::size_t max_schedules_without_improvement = 0;
+        };
+
+        /**
+         * @brief reason why an annealing run is stopped
+         */
+        enum class StopReason {
+            completed,            ///< all the schedules are done
+            no_acceptance,        ///< StoppingCriteria::max_steps_without_acceptance
+            target_energy,        ///< StoppingCriteria::target_energy
+            no_improvement,       ///< StoppingCriteria::max_schedules_without_improvement
+        };
+
+        /**
+         * @brief report of an annealing run with stopping criteria
+         */
+        struct RunReport {
+
+            /**
+             * @brief criterion which fired
+             */
+            StopReason reason = StopReason::completed;
+
+            /**
+             * @brief number of Monte Carlo steps done
+             */
+            std::size_t num_steps = 0;
+
+            /**
+             * @brief index of the schedule in which the run is stopped (the number of schedules if completed)
+             */
+            std::size_t schedule_index = 0;
+        };
+
+    } // namespace algorithm
+} // namespace openjij
+
+#endif
@@ -0,0 +1,366 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_ALGORITHM_TABU_SEARCH_HPP__
+#define OPENJIJ_ALGORITHM_TABU_SEARCH_HPP__
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <system/classical_ising.hpp>
+
+namespace openjij {
+    namespace algorithm {
+
+        /**
+         * @brief parameters of tabu search
+         */
+        struct TabuSearchParameter {
+
+            /**
+             * @brief maximum number of moves (single spin flips) in each run
+             */
+            std::size_t num_iterations = 10000;
+
+            /**
+             * @brief number of moves during which a flipped spin cannot be flipped back (0: min(20, num_spins/4) + 1)
+             */
+            std::size_t tenure = 0;
+
+            /**
+             * @brief number of runs after the first one. each restart begins with the best spins found so far, partially randomized
+             */
+            std::size_t num_restarts = 10;
+
+            /**
+             * @brief a run is finished if the best energy is not improved for this number of moves (0: disabled)
+             */
+            std::size_t max_stagnation = 1000;
+
+            /**
+             * @brief fraction of the spins flipped at random at a restart
+             */
+            double restart_perturbation = 0.25;
+
+            /**
+             * @brief check the parameters
+             *
+             * @throw std::invalid_argument if a parameter is out of range
+             */
+            void validate() const {
+                if(!(0 < restart_perturbation && restart_perturbation <= 1)) {
+                    throw std::invalid_argument("restart_perturbation must be in (0, 1]");
+                }
+            }
+
+            /**
+             * @brief tenure for the given number of spins (always smaller than num_spins)
+             *
+             * @param num_spins
+             */
+            std::size_t tenure_for(std::size_t num_spins) const {
+                const std::size_t value = (tenure == 0) ? std::min<std::size_t>(20, num_spins/4) + 1 : tenure;
+                return std::min(value, (num_spins > 0) ? num_spins - 1 : 0);
+            }
+        };
+
+        /**
+         * @brief report of tabu search
+         */
+        struct TabuSearchReport {
+
+            /**
+             * @brief the lowest energy found (the system is left in the spins of this energy)
+             */
+            double best_energy = 0;
+
+            /**
+             * @brief number of moves done in all the runs
+             */
+            std::size_t num_iterations = 0;
+
+            /**
+             * @brief number of runs (including the first one)
+             */
+            std::size_t num_runs = 0;
+        };
+
+        /**
+         * @brief tabu search with single spin flip moves for classical ising systems
+         *
+         * @details at each move, the spin with the lowest energy difference is flipped among the spins which are not tabu.
+         * a tabu spin is also allowed if the flip gives an energy lower than the best one (aspiration).
+         * ties are broken at random. the energy differences are read from the local fields of ClassicalIsing::workspace,
+         * which are updated in O(degree) after each flip (O(num_spins) for dense interactions).
+         *
+         * for dense interactions, a move is selected by scanning all the spins, which costs as much as the update of the local fields.
+         * for sparse interactions, the spins are kept in a lazy min-heap keyed by the energy difference (see SteepestDescent),
+         * and the tabu spins (at most tenure + 1) are skipped while popping, so that a move costs O((degree + tenure) log num_spins).
+         * the best spins are kept by a journal of flips (system::BestSpinTracker) instead of a copy at each improvement.
+         */
+        struct TabuSearch {
+
+            /**
+             * @brief run tabu search from the current spins of the system
+             *
+             * @param system classical ising system (Dense or Sparse). the system is left in the best spins found
+             * @param random_number_engine
+             * @param parameter
+             *
+             * @return report
+             */
+            template<typename System, typename RandomNumberEngine>
+            static TabuSearchReport run(System& system,
+                                        RandomNumberEngine& random_number_engine,
+                                        const TabuSearchParameter& parameter) {
+                static_assert(std::is_same<typename system::get_system_type<System>::type, system::classical_system>::value,
+                        "tabu search is only for classical systems");
+                parameter.validate();
+
+                const std::size_t num_spins = system.num_spins;
+                const std::size_t tenure = parameter.tenure_for(num_spins);
+                auto urd = std::uniform_real_distribution<>(0, 1.0);
+
+                system.fix_gauge();
+                system.synchronize_local_field();
+
+                TabuSearchReport report;
+                system::BestSpinTracker<typename System::VectorXx> best_spin_tracker;
+                best_spin_tracker.reset(system.spin);
+                double best_energy = system.observables.energy;
+                MoveSelection<System> move_selection;
+
+                const auto flip = [&](std::size_t i) {
+                    system.flip_with_local_field(i);
+                    best_spin_tracker.flipped(i);
+                };
+
+                // iteration at which each spin is released from the tabu list
+                std::vector<std::size_t> tabu_until(num_spins, 0);
+
+                for (std::size_t run = 0; run <= parameter.num_restarts && num_spins > 0; ++run) {
+                    if (run > 0) {
+                        // restart from the best spins with random flips
+                        move_to(system, best_spin_tracker.best_spin, flip);
+                        for (std::size_t i = 0; i < num_spins; ++i) {
+                            if (urd(random_number_engine) < parameter.restart_perturbation) {
+                                flip(i);
+                            }
+                        }
+                    }
+                    std::fill(tabu_until.begin(), tabu_until.end(), 0);
+                    move_selection.reset(system, random_number_engine);
+                    ++report.num_runs;
+
+                    std::size_t last_improvement = 0;
+                    for (std::size_t iteration = 1; iteration <= parameter.num_iterations; ++iteration) {
+                        const double energy = system.observables.energy;
+
+                        // the best allowed move
+                        const auto allowed = [&](std::size_t i, double dE) {
+                            return tabu_until[i] <= iteration || energy + dE < best_energy;
+                        };
+                        const std::size_t selected = move_selection.select(system, allowed, random_number_engine);
+                        // a move is always allowed since tenure < num_spins
+                        assert(selected < num_spins);
+                        flip(selected);
+                        move_selection.flipped(system, selected, random_number_engine);
+                        tabu_until[selected] = iteration + tenure + 1;
+                        ++report.num_iterations;
+
+                        if (system.observables.energy < best_energy) {
+                            best_energy = system.observables.energy;
+                            best_spin_tracker.improved(system.spin);
+                            last_improvement = iteration;
+                        }
+                        else if (parameter.max_stagnation > 0 && iteration - last_improvement >= parameter.max_stagnation) {
+                            break;
+                        }
+                    }
+                }
+
+                move_to(system, best_spin_tracker.best_spin, flip);
+                report.best_energy = best_energy;
+                return report;
+            }
+
+        private:
+
+            /**
+             * @brief flip the spins which differ from the target by flip(i) (the local fields and the observables are kept up to date)
+             */
+            template<typename System, typename SpinVector, typename Flip>
+            static void move_to(System& system, const SpinVector& target, Flip&& flip) {
+                for (std::size_t i = 0; i < system.num_spins; ++i) {
+                    if (system.spin(i) != target(i)) {
+                        flip(i);
+                    }
+                }
+            }
+
+            /**
+             * @brief selection of the move with the lowest energy difference among the allowed spins
+             *
+             * @tparam System type of system
+             */
+            template<typename System>
+            struct MoveSelection;
+
+            /**
+             * @brief move selection for dense interactions by scanning all the spins (reservoir sampling among ties)
+             */
+            template<typename FloatType>
+            struct MoveSelection<system::ClassicalIsing<graph::Dense<FloatType>>> {
+                using ClIsing = system::ClassicalIsing<graph::Dense<FloatType>>;
+
+                /**
+                 * @brief prepare the selection for the current spins
+                 */
+                template<typename RandomNumberEngine>
+                void reset(const ClIsing&, RandomNumberEngine&) {}
+
+                /**
+                 * @brief spin with the lowest energy difference among the spins i with allowed(i, dE) (num_spins if there is none)
+                 */
+                template<typename Allowed, typename RandomNumberEngine>
+                std::size_t select(const ClIsing& system, Allowed&& allowed, RandomNumberEngine& random_number_engine) {
+                    std::size_t selected = system.num_spins;
+                    double selected_dE = std::numeric_limits<double>::infinity();
+                    std::size_t num_ties = 0;
+                    for (std::size_t i = 0; i < system.num_spins; ++i) {
+                        const double dE = system.delta_energy(i);
+                        if (dE > selected_dE || !allowed(i, dE)) {
+                            continue;
+                        }
+                        if (dE < selected_dE) {
+                            selected = i;
+                            selected_dE = dE;
+                            num_ties = 1;
+                        }
+                        else if (std::uniform_int_distribution<std::size_t>(0, num_ties++)(random_number_engine) == 0) {
+                            selected = i;
+                        }
+                    }
+                    return selected;
+                }
+
+                /**
+                 * @brief update the selection after ith spin is flipped
+                 */
+                template<typename RandomNumberEngine>
+                void flipped(const ClIsing&, std::size_t, RandomNumberEngine&) {}
+            };
+
+            /**
+             * @brief move selection for sparse interactions by a lazy min-heap of the energy differences
+             *
+             * @details an entry is (dE, random key, index, version). the random key breaks ties uniformly.
+             * after a flip, the flipped spin and its neighbors are pushed again with a new version and outdated entries are dropped when popped.
+             */
+            template<typename FloatType>
+            struct MoveSelection<system::ClassicalIsing<graph::Sparse<FloatType>>> {
+                using ClIsing = system::ClassicalIsing<graph::Sparse<FloatType>>;
+                using Entry = std::tuple<double, double, std::size_t, std::size_t>;
+
+                /**
+                 * @brief push all the spins
+                 */
+                template<typename RandomNumberEngine>
+                void reset(const ClIsing& system, RandomNumberEngine& random_number_engine) {
+                    version.assign(system.num_spins, 0);
+                    heap.clear();
+                    for (std::size_t i = 0; i < system.num_spins; ++i) {
+                        heap.emplace_back(system.delta_energy(i), urd(random_number_engine), i, 0);
+                    }
+                    std::make_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                }
+
+                /**
+                 * @brief spin with the lowest energy difference among the spins i with allowed(i, dE) (num_spins if there is none).
+                 * the spins which are not allowed are popped and pushed back.
+                 */
+                template<typename Allowed, typename RandomNumberEngine>
+                std::size_t select(const ClIsing& system, Allowed&& allowed, RandomNumberEngine&) {
+                    std::size_t selected = system.num_spins;
+                    while (!heap.empty()) {
+                        const Entry entry = heap.front();
+                        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                        heap.pop_back();
+                        const std::size_t i = std::get<2>(entry);
+                        if (std::get<3>(entry) != version[i]) {
+                            continue;
+                        }
+                        skipped.push_back(entry);
+                        if (allowed(i, std::get<0>(entry))) {
+                            selected = i;
+                            break;
+                        }
+                    }
+                    for (const auto& entry : skipped) {
+                        heap.push_back(entry);
+                        std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                    }
+                    skipped.clear();
+                    return selected;
+                }
+
+                /**
+                 * @brief push the flipped spin and its neighbors again
+                 */
+                template<typename RandomNumberEngine>
+                void flipped(const ClIsing& system, std::size_t index, RandomNumberEngine& random_number_engine) {
+                    push(system, index, random_number_engine);
+                    for (typename ClIsing::SparseMatrixXx::InnerIterator it(system.interaction, index); it; ++it) {
+                        const std::size_t j = it.index();
+                        if (j < system.num_spins && j != index) {
+                            push(system, j, random_number_engine);
+                        }
+                    }
+
+                    // drop the outdated entries if the heap gets too large
+                    if (heap.size() > 4 * system.num_spins + 16) {
+                        heap.erase(std::remove_if(heap.begin(), heap.end(),
+                                    [&](const Entry& entry){ return std::get<3>(entry) != version[std::get<2>(entry)]; }),
+                                heap.end());
+                        std::make_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                    }
+                }
+
+            private:
+                template<typename RandomNumberEngine>
+                void push(const ClIsing& system, std::size_t i, RandomNumberEngine& random_number_engine) {
+                    heap.emplace_back(system.delta_energy(i), urd(random_number_engine), i, ++version[i]);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                }
+
+                std::vector<Entry> heap;
+                std::vector<Entry> skipped;
+                std::vector<std::size_t> version;
+                std::uniform_real_distribution<> urd = std::uniform_real_distribution<>(0, 1.0);
+            };
+        };
+
+    } // namespace algorithm
+} // namespace openjij
+
+#endif
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 
 #ifdef USE_CUDA
 #include <utility/gpu/memory.hpp>
@@ -46,41 +47,97 @@ namespace openjij {
             return ret_spins;
         }
 
+        /**
+         * @brief get the spins with the lowest energy seen since the last reset of classical ising system
+         *
+         * @tparam GraphType graph type
+         * @param system classical ising system with track_best_spin set
+         *
+         * @return best solution
+         */
+        template<typename GraphType>
+        const graph::Spins get_best_solution(const system::ClassicalIsing<GraphType>& system){
+            if(!system.track_best_spin){
+                throw std::runtime_error("best spin tracking is disabled. call set_track_best_spin(true) before the annealing.");
+            }
+            const auto& best_spin = system.best_spin();
+            graph::Spins ret_spins(system.num_spins);
+            for(std::size_t i=0; i<system.num_spins; i++){
+                ret_spins[i] = best_spin(i)*best_spin(system.num_spins);
+            }
+            return ret_spins;
+        }
+
         /**
          * @brief get solution of transverse ising system
          *
          * @tparam GraphType
          * @param system
          *
-         * @return solution
+         * @return solution (trotter slice with the minimum classical energy)
          */
         template<typename GraphType>
         const graph::Spins get_solution(const system::TransverseIsing<GraphType>& system){
+            //slice energies are kept up to date by the system
+            typename system::TransverseIsing<GraphType>::SliceEnergy::Index minimum_trotter;
+            system.slice_energy.minCoeff(&minimum_trotter);
+
+            //convert from Eigen::Vector to std::vector
+            graph::Spins ret_spins(system.num_classical_spins);
+            for(std::size_t i=0; i<system.num_classical_spins; i++){
+                ret_spins[i] = system.trotter_spins(i, minimum_trotter);
+            }
+            return ret_spins;
+        }
+
+        /**
+         * @brief get classical energy of the solution of transverse ising system
+         *
+         * @tparam GraphType
+         * @param system
+         *
+         * @return energy of the trotter slice returned by get_solution
+         */
+        template<typename GraphType>
+        typename GraphType::value_type get_energy(const system::TransverseIsing<GraphType>& system){
+            return system.slice_energy.minCoeff();
+        }
+
+        /**
+         * @brief get solution of transverse ising system with packed trotter spins
+         *
+         * @tparam GraphType
+         * @param system
+         *
+         * @return solution (trotter slice with the minimum classical energy)
+         */
+        template<typename GraphType>
+        const graph::Spins get_solution(const system::PackedTransverseIsing<GraphType>& system){
+            using FloatType = typename GraphType::value_type;
             std::size_t minimum_trotter = 0;
-            //aliases
-            auto& spins = system.trotter_spins;
-            double energy = 0.0;
             double min_energy = std::numeric_limits<double>::max();
-            //get number of trotter slices
-            std::size_t num_trotter_slices = system.trotter_spins.cols();
-            for (std::size_t t=0; t<num_trotter_slices; t++){
+
+            Eigen::Matrix<FloatType, Eigen::Dynamic, 1> slice(system.num_classical_spins+1);
+            slice(system.num_classical_spins) = 1; //dummy spin
+            for (std::size_t t=0; t<system.num_trotter_slices; t++){
+                for(std::size_t i=0; i<system.num_classical_spins; i++){
+                    slice(i) = system.spin(i, t);
+                }
                 // calculate classical energy in each classical spin
-                energy = spins.col(t).transpose() * system.interaction * spins.col(t);
+                double energy = slice.transpose() * system.interaction * slice;
                 if(energy < min_energy){
                     minimum_trotter = t;
                     min_energy = energy;
                 }
             }
 
-            //convert from Eigen::Vector to std::vector
             graph::Spins ret_spins(system.num_classical_spins);
             for(std::size_t i=0; i<system.num_classical_spins; i++){
-                ret_spins[i] = spins(i, minimum_trotter);
+                ret_spins[i] = system.spin(i, minimum_trotter);
             }
             return ret_spins;
         }
 
-
      	/**
          * @brief get solution of continuous time Ising system
          *
@@ -18,8 +18,10 @@
 //disable eigen -Wdeprecated-copy warning
 #include <utility/disable_eigen_warning.hpp>
 
+#include <system/observables.hpp>
 #include <system/classical_ising.hpp>
 #include <system/transverse_ising.hpp>
+#include <system/packed_transverse_ising.hpp>
 #include <system/continuous_time_ising.hpp>
 
 #ifdef USE_CUDA
@@ -15,12 +15,17 @@
 #ifndef OPENJIJ_SYSTEM_CLASSICAL_ISING_HPP__
 #define OPENJIJ_SYSTEM_CLASSICAL_ISING_HPP__
 
+#include <any>
 #include <cassert>
+#include <cstddef>
+#include <limits>
 #include <utility>
 #include <system/system.hpp>
+#include <system/observables.hpp>
 #include <graph/all.hpp>
 #include <utility/eigen.hpp>
 #include <type_traits>
+#include <vector>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
@@ -36,32 +41,55 @@ namespace openjij {
         template<typename GraphType>
             struct ClassicalIsing;
 
-
         /**
-         * @brief ClassicalIsing structure for Dense graph (Eigen-based)
+         * @brief common part of ClassicalIsing for Dense and Sparse graphs (CRTP).
+         * Derived has the interaction matrix and update_local_field, which adds the change of the local fields by a flip to workspace.local_field.
          *
+         * @tparam Derived ClassicalIsing<GraphType>
          * @tparam FloatType type of floating-point
          */
-        template<typename FloatType>
-            struct ClassicalIsing<graph::Dense<FloatType>>{
+        template<typename Derived, typename FloatType>
+            struct ClassicalIsingBase{
                 using system_type = classical_system;
 
-                //matrix (row major)
-                using MatrixXx = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
                 //vector (col major)
                 using VectorXx = Eigen::Matrix<FloatType, Eigen::Dynamic, 1, Eigen::ColMajor>;
 
                 /**
-                 * @brief Constructor to initialize spin and interaction
+                 * @brief buffers reused by the updaters across sweeps (not a part of the spin state)
+                 */
+                struct Workspace {
+                    /**
+                     * @brief local fields (interaction * spin) of the spins at spin_revision
+                     */
+                    VectorXx local_field;
+
+                    /**
+                     * @brief ClassicalIsing::spin_revision for which local_field is computed (recomputed if the spins are changed by others)
+                     */
+                    std::size_t spin_revision = std::numeric_limits<std::size_t>::max();
+
+                    /**
+                     * @brief number of flips since local_field is computed from scratch
+                     */
+                    std::size_t num_incremental_flips = 0;
+
+                    /**
+                     * @brief state kept by an updater across updates (e.g. the flip rates of NFoldWay), owned and interpreted by the updater
+                     */
+                    std::any updater_workspace;
+                };
+
+                /**
+                 * @brief Constructor to initialize spin (the observables are computed by Derived after the interaction is initialized)
                  *
-                 * @param spin
-                 * @param interaction
+                 * @param init_spin
+                 * @param num_spins number of real spins
                  */
-                ClassicalIsing(const graph::Spins& init_spin, const graph::Dense<FloatType>& init_interaction)
+                ClassicalIsingBase(const graph::Spins& init_spin, std::size_t num_spins)
                     : spin(utility::gen_vector_from_std_vector<FloatType, Eigen::ColMajor>(init_spin)),
-                    interaction(init_interaction.get_interactions()),
-                    num_spins(init_interaction.get_num_spins()){
-                        assert(init_spin.size() == init_interaction.get_num_spins());
+                    num_spins(num_spins){
+                        assert(init_spin.size() == num_spins);
                     }
 
                 /**
@@ -71,37 +99,211 @@ namespace openjij {
                  */
                 void reset_spins(const graph::Spins& init_spin){
                     this->spin = utility::gen_vector_from_std_vector<FloatType, Eigen::ColMajor>(init_spin);
+                    reset_observables();
+                }
+
+                /**
+                 * @brief energy computed from the spins (O(N^2) for Dense, O(number of edges) for Sparse)
+                 */
+                FloatType calc_energy() const {
+                    const auto& interaction = derived().interaction;
+                    //the corner of the interaction is a constant
+                    return (spin.dot(interaction*spin) - interaction.coeff(num_spins, num_spins))/2;
+                }
+
+                /**
+                 * @brief magnetization computed from the spins (the sign of the dummy spin is taken into account)
+                 */
+                FloatType calc_magnetization() const {
+                    return spin(num_spins)*(spin.sum() - spin(num_spins));
+                }
+
+                /**
+                 * @brief recompute observables from the spins and reset the acceptance counts and the best energy (and spins)
+                 */
+                void reset_observables(){
+                    ++spin_revision;
+                    observables.reset(calc_energy(), calc_magnetization());
+                    if(track_best_spin){
+                        best_spin_tracker.reset(spin);
+                    }
                 }
 
                 /**
-                 * @brief spins (Eigen Vector)
+                 * @brief recompute energy and magnetization after spins are changed at once (e.g. cluster updates)
+                 */
+                void refresh_observables(){
+                    ++spin_revision;
+                    const bool improved = observables.set(calc_energy(), calc_magnetization());
+                    if(track_best_spin){
+                        if(improved){
+                            best_spin_tracker.reset(spin);
+                        }
+                        else{
+                            best_spin_tracker.invalidate();
+                        }
+                    }
+                }
+
+                /**
+                 * @brief flip ith spin, keeping the observables (and the best spins) up to date
+                 *
+                 * @param index
+                 * @param dE energy difference of the flip
+                 */
+                void flip(std::size_t index, FloatType dE){
+                    const bool improved = observables.accept(dE, -2*spin(index)*spin(num_spins));
+                    spin(index) *= -1;
+                    ++spin_revision;
+                    if(track_best_spin){
+                        best_spin_tracker.flipped(index);
+                        if(improved){
+                            best_spin_tracker.improved(spin);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief make workspace.local_field consistent with the spins.
+                 * it is recomputed from scratch only if the spins are changed without updating it, i.e. spin_revision is changed (or after max_incremental_flips_per_spin * num_spins flips).
+                 * the check is O(1).
+                 *
+                 * @return true if recomputed
+                 */
+                bool synchronize_local_field(){
+                    if(workspace.spin_revision == spin_revision
+                            && workspace.num_incremental_flips <= max_incremental_flips_per_spin * num_spins){
+                        return false;
+                    }
+                    workspace.local_field = derived().interaction * spin;
+                    workspace.spin_revision = spin_revision;
+                    workspace.num_incremental_flips = 0;
+                    return true;
+                }
+
+                /**
+                 * @brief energy difference by flipping ith spin (workspace.local_field must be synchronized)
+                 *
+                 * @param index
+                 */
+                FloatType delta_energy(std::size_t index) const {
+                    return -2 * spin(index) * workspace.local_field(index);
+                }
+
+                /**
+                 * @brief flip ith spin, keeping the observables and workspace.local_field up to date (O(num_spins) for Dense, O(degree) for Sparse)
+                 *
+                 * @param index
+                 */
+                void flip_with_local_field(std::size_t index){
+                    const FloatType old_spin = spin(index);
+                    const bool synchronized = (workspace.spin_revision == spin_revision);
+                    flip(index, delta_energy(index));
+                    if(synchronized){
+                        workspace.spin_revision = spin_revision;
+                    }
+                    ++workspace.num_incremental_flips;
+                    derived().update_local_field(index, old_spin);
+                }
+
+                /**
+                 * @brief flip all the spins if the dummy spin is -1 (some updaters, e.g. SwendsenWang, may flip it).
+                 * the energy and the magnetization are invariant.
+                 */
+                void fix_gauge(){
+                    if(spin(num_spins) < 0){
+                        spin *= -1;
+                        ++spin_revision;
+                        if(track_best_spin){
+                            best_spin_tracker.invalidate();
+                        }
+                    }
+                }
+
+                /**
+                 * @brief enable or disable keeping the spins with the lowest energy (the best energy is reset to the current one)
+                 *
+                 * @param enable
+                 */
+                void set_track_best_spin(bool enable){
+                    track_best_spin = enable;
+                    observables.best_energy = observables.energy;
+                    if(track_best_spin){
+                        best_spin_tracker.reset(spin);
+                    }
+                }
+
+                /**
+                 * @brief spins with the lowest energy since the last reset (valid only if track_best_spin is set)
+                 */
+                const VectorXx& best_spin() const {
+                    return best_spin_tracker.best_spin;
+                }
+
+                /**
+                 * @brief spins (Eigen Vector).
+                 * if the spins are written directly, call reset_observables or refresh_observables afterwards (the observables and spin_revision are updated)
                  */
                 VectorXx spin;
 
                 /**
-                 * @brief interactions (Eigen Matrix)
+                 * @brief incremented whenever the spins are changed through the member functions (used to invalidate workspace in O(1))
                  */
-                const MatrixXx interaction;
+                std::size_t spin_revision = 0;
 
                 /**
                  * @brief number of real spins (dummy spin excluded)
                  */
                 const std::size_t num_spins; //spin.size()-1
+
+                /**
+                 * @brief observables maintained by the updaters
+                 */
+                Observables<FloatType> observables;
+
+                /**
+                 * @brief whether the spins with the lowest energy are kept (use set_track_best_spin to change)
+                 */
+                bool track_best_spin = false;
+
+                /**
+                 * @brief tracker of the spins with the lowest energy
+                 */
+                BestSpinTracker<VectorXx> best_spin_tracker;
+
+                /**
+                 * @brief buffers for updaters
+                 */
+                Workspace workspace;
+
+                /**
+                 * @brief workspace.local_field is recomputed from scratch after this number of flips per spin, so that rounding errors do not accumulate
+                 */
+                static constexpr std::size_t max_incremental_flips_per_spin = 100;
+
+            private:
+
+                const Derived& derived() const {
+                    return static_cast<const Derived&>(*this);
+                }
+
+                Derived& derived() {
+                    return static_cast<Derived&>(*this);
+                }
             };
 
+
         /**
-         * @brief ClassicalIsing structure for Sparse graph (Eigen-based)
+         * @brief ClassicalIsing structure for Dense graph (Eigen-based)
          *
          * @tparam FloatType type of floating-point
          */
         template<typename FloatType>
-            struct ClassicalIsing<graph::Sparse<FloatType>>{
-                using system_type = classical_system;
+            struct ClassicalIsing<graph::Dense<FloatType>> : ClassicalIsingBase<ClassicalIsing<graph::Dense<FloatType>>, FloatType>{
+                using Base = ClassicalIsingBase<ClassicalIsing<graph::Dense<FloatType>>, FloatType>;
 
                 //matrix (row major)
-                using SparseMatrixXx = Eigen::SparseMatrix<FloatType, Eigen::RowMajor>;
-                //vector (col major)
-                using VectorXx = Eigen::Matrix<FloatType, Eigen::Dynamic, 1, Eigen::ColMajor>;
+                using MatrixXx = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
                 /**
                  * @brief Constructor to initialize spin and interaction
@@ -109,36 +311,68 @@ namespace openjij {
                  * @param spin
                  * @param interaction
                  */
-                ClassicalIsing(const graph::Spins& init_spin, const graph::Sparse<FloatType>& init_interaction)
-                    : spin(utility::gen_vector_from_std_vector<FloatType, Eigen::ColMajor>(init_spin)),
-                    interaction(utility::gen_matrix_from_graph<Eigen::RowMajor>(init_interaction)),
-                    num_spins(init_interaction.get_num_spins()){
-                        assert(init_spin.size() == init_interaction.get_num_spins());
+                ClassicalIsing(const graph::Spins& init_spin, const graph::Dense<FloatType>& init_interaction)
+                    : Base(init_spin, init_interaction.get_num_spins()),
+                    interaction(init_interaction.get_interactions()){
+                        this->reset_observables();
                     }
 
                 /**
-                 * @brief reset spins
+                 * @brief add the change of the local fields by flipping ith spin to workspace.local_field (O(num_spins))
                  *
-                 * @param init_spin
+                 * @param index
+                 * @param old_spin value of ith spin before the flip
                  */
-                void reset_spins(const graph::Spins& init_spin){
-                    this->spin = utility::gen_vector_from_std_vector<FloatType, Eigen::ColMajor>(init_spin);
+                void update_local_field(std::size_t index, FloatType old_spin){
+                    this->workspace.local_field += (-2 * old_spin) * interaction.row(index).transpose();
                 }
 
                 /**
-                 * @brief spins (Eigen Vector)
+                 * @brief interactions (Eigen Matrix)
                  */
-                VectorXx spin;
+                const MatrixXx interaction;
+            };
+
+        /**
+         * @brief ClassicalIsing structure for Sparse graph (Eigen-based)
+         *
+         * @tparam FloatType type of floating-point
+         */
+        template<typename FloatType>
+            struct ClassicalIsing<graph::Sparse<FloatType>> : ClassicalIsingBase<ClassicalIsing<graph::Sparse<FloatType>>, FloatType>{
+                using Base = ClassicalIsingBase<ClassicalIsing<graph::Sparse<FloatType>>, FloatType>;
+
+                //matrix (row major)
+                using SparseMatrixXx = Eigen::SparseMatrix<FloatType, Eigen::RowMajor>;
 
                 /**
-                 * @brief interaction (Eigen SparseMatrix)
+                 * @brief Constructor to initialize spin and interaction
+                 *
+                 * @param spin
+                 * @param interaction
                  */
-                const SparseMatrixXx interaction;
+                ClassicalIsing(const graph::Spins& init_spin, const graph::Sparse<FloatType>& init_interaction)
+                    : Base(init_spin, init_interaction.get_num_spins()),
+                    interaction(utility::gen_matrix_from_graph<Eigen::RowMajor>(init_interaction)){
+                        this->reset_observables();
+                    }
 
                 /**
-                 * @brief number of real spins (dummy spin excluded)
+                 * @brief add the change of the local fields by flipping ith spin to workspace.local_field (O(degree))
+                 *
+                 * @param index
+                 * @param old_spin value of ith spin before the flip
                  */
-                const std::size_t num_spins; //spin.size()-1
+                void update_local_field(std::size_t index, FloatType old_spin){
+                    for(typename SparseMatrixXx::InnerIterator it(interaction, index); it; ++it){
+                        this->workspace.local_field(it.index()) += -2 * old_spin * it.value();
+                    }
+                }
+
+                /**
+                 * @brief interaction (Eigen SparseMatrix)
+                 */
+                const SparseMatrixXx interaction;
             };
 
         /**
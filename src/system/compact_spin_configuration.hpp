@@ -0,0 +1,319 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_SYSTEM_COMPACT_SPIN_CONFIGURATION_HPP__
+#define OPENJIJ_SYSTEM_COMPACT_SPIN_CONFIGURATION_HPP__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <graph/graph.hpp>
+
+namespace openjij {
+    namespace system {
+
+        /**
+         * @brief spin configuration in continuous time space stored as structure of arrays
+         *
+         * @details time points of all the sites are concatenated into one contiguous array, and
+         * the time points of ith site are times(i)[0] ... times(i)[size(i)-1] (sorted).
+         * the spin value after each time point is packed into one bit (set for +1).
+         * a time point is also numbered by offset(i)+k over all the sites (e.g. for union-find trees).
+         *
+         * a configuration is built site by site with append and close_site, and the capacities are reused after clear.
+         *
+         * @tparam TimeType
+         */
+        template<typename TimeType>
+        class CompactSpinConfiguration {
+        public:
+            using CutPoint = std::pair<TimeType, graph::Spin>;
+            using SpinConfiguration = std::vector<std::vector<CutPoint>>;
+            using Word = std::uint64_t;
+
+            static constexpr std::size_t word_bits = 64;
+
+            CompactSpinConfiguration() : _offsets{0} {}
+
+            /**
+             * @brief CompactSpinConfiguration constructor
+             *
+             * @param spin_config
+             */
+            explicit CompactSpinConfiguration(const SpinConfiguration& spin_config) : CompactSpinConfiguration() {
+                assign(spin_config);
+            }
+
+            /**
+             * @brief remove all the sites, keeping the allocated storage
+             */
+            void clear() {
+                _times.clear();
+                _offsets.assign(1, 0);
+                _spins.clear();
+            }
+
+            /**
+             * @brief replace the contents with given spin configuration
+             *
+             * @param spin_config
+             */
+            void assign(const SpinConfiguration& spin_config) {
+                clear();
+                for(const auto& timeline : spin_config) {
+                    push_back(timeline);
+                }
+            }
+
+            /**
+             * @brief append timeline as a new site
+             *
+             * @param timeline
+             */
+            void push_back(const std::vector<CutPoint>& timeline) {
+                assert(timeline.size() > 0);
+                for(const auto& cut_point : timeline) {
+                    append(cut_point.first, cut_point.second);
+                }
+                close_site();
+            }
+
+            /**
+             * @brief append a time point to the site being built (the time points must be sorted)
+             *
+             * @param time_point
+             * @param spin spin value after the time point
+             */
+            void append(TimeType time_point, graph::Spin spin) {
+                const std::size_t index = _times.size();
+                _times.push_back(time_point);
+                if(index % word_bits == 0) {
+                    _spins.push_back(0);
+                }
+                if(spin > 0) {
+                    _spins[index / word_bits] |= (Word(1) << (index % word_bits));
+                }
+            }
+
+            /**
+             * @brief finish the site being built
+             */
+            void close_site() {
+                assert(_times.size() > _offsets.back());
+                _offsets.push_back(_times.size());
+            }
+
+            /**
+             * @brief append all the sites of other
+             *
+             * @param other
+             */
+            void append(const CompactSpinConfiguration& other) {
+                const std::size_t base = _times.size();
+                _times.insert(_times.end(), other._times.begin(), other._times.end());
+                for(std::size_t i = 1;i < other._offsets.size();i++) {
+                    _offsets.push_back(base + other._offsets[i]);
+                }
+
+                /* the bits after the last time point are zero in both */
+                const std::size_t first_word = base / word_bits;
+                const std::size_t shift = base % word_bits;
+                _spins.resize((_times.size() + word_bits - 1) / word_bits, 0);
+                for(std::size_t w = 0;w < other._spins.size();w++) {
+                    const Word word = other._spins[w];
+                    _spins[first_word + w] |= word << shift;
+                    if(shift > 0 && first_word + w + 1 < _spins.size()) {
+                        _spins[first_word + w + 1] |= word >> (word_bits - shift);
+                    }
+                }
+            }
+
+            /**
+             * @brief convert to the spin configuration
+             *
+             * @param spin_config buffer to be overwritten (the capacity of each timeline is reused)
+             */
+            void copy_to(SpinConfiguration& spin_config) const {
+                spin_config.resize(num_sites());
+                for(std::size_t i = 0;i < num_sites();i++) {
+                    auto& timeline = spin_config[i];
+                    timeline.resize(size(i));
+                    for(std::size_t k = 0;k < size(i);k++) {
+                        timeline[k] = CutPoint(time(i, k), spin(i, k));
+                    }
+                }
+            }
+
+            /**
+             * @brief convert to the spin configuration
+             */
+            SpinConfiguration to_spin_configuration() const {
+                SpinConfiguration spin_config;
+                copy_to(spin_config);
+                return spin_config;
+            }
+
+            /**
+             * @brief return time-direction index which exists just before time_point at "site_index"th site.
+             * The periodic boundary condition for time direction is taken into account.
+             *
+             * @param site_index spacial index of site
+             * @param time_point time-direction point
+             */
+            std::size_t get_temporal_spin_index(graph::Index site_index, TimeType time_point) const {
+                const auto first = times(site_index);
+                const auto last = first + size(site_index);
+                auto found_itr = std::upper_bound(first, last, time_point);
+
+                if(found_itr == first) { // if the time_point lies before any time points
+                    found_itr = last; // periodic boundary condition
+                }
+
+                return std::distance(first, found_itr) - 1;
+            }
+
+            /**
+             * @brief number of sites
+             */
+            std::size_t num_sites() const {
+                return _offsets.size() - 1;
+            }
+
+            /**
+             * @brief number of time points of all the sites (including the site being built)
+             */
+            std::size_t num_time_points() const {
+                return _times.size();
+            }
+
+            /**
+             * @brief number of time points at ith site
+             *
+             * @param site_index
+             */
+            std::size_t size(graph::Index site_index) const {
+                return _offsets[site_index+1] - _offsets[site_index];
+            }
+
+            /**
+             * @brief 1 dimensionalized index of the first time point at ith site, offset(num_sites()) is the total number of time points
+             *
+             * @param site_index
+             */
+            std::size_t offset(graph::Index site_index) const {
+                return _offsets[site_index];
+            }
+
+            /**
+             * @brief pointer to the sorted time points at ith site
+             *
+             * @param site_index
+             */
+            const TimeType* times(graph::Index site_index) const {
+                return _times.data() + _offsets[site_index];
+            }
+
+            /**
+             * @brief kth time point at ith site
+             */
+            TimeType time(graph::Index site_index, std::size_t k) const {
+                return _times[_offsets[site_index] + k];
+            }
+
+            /**
+             * @brief spin value after kth time point at ith site
+             */
+            graph::Spin spin(graph::Index site_index, std::size_t k) const {
+                return spin_at(_offsets[site_index] + k);
+            }
+
+            /**
+             * @brief spin value after the time point of 1 dimensionalized index
+             */
+            graph::Spin spin_at(std::size_t index) const {
+                return ((_spins[index / word_bits] >> (index % word_bits)) & 1) ? 1 : -1;
+            }
+
+            /**
+             * @brief flip spin value after the time point of 1 dimensionalized index.
+             * the time points in different words (index / word_bits) can be flipped by different threads.
+             */
+            void flip_at(std::size_t index) {
+                _spins[index / word_bits] ^= (Word(1) << (index % word_bits));
+            }
+
+            /**
+             * @brief flip spin value after kth time point at ith site
+             */
+            void flip(graph::Index site_index, std::size_t k) {
+                flip_at(_offsets[site_index] + k);
+            }
+
+            /**
+             * @brief number of words of the packed spins
+             */
+            std::size_t num_words() const {
+                return _spins.size();
+            }
+
+            /**
+             * @brief packed spins (the bits after the last time point are zero)
+             */
+            const std::vector<Word>& words() const {
+                return _spins;
+            }
+
+            /**
+             * @brief exchange the contents (and the storage)
+             */
+            void swap(CompactSpinConfiguration& other) {
+                _times.swap(other._times);
+                _offsets.swap(other._offsets);
+                _spins.swap(other._spins);
+            }
+
+            friend bool operator==(const CompactSpinConfiguration& lhs, const CompactSpinConfiguration& rhs) {
+                return lhs._offsets == rhs._offsets && lhs._times == rhs._times && lhs._spins == rhs._spins;
+            }
+
+            friend bool operator!=(const CompactSpinConfiguration& lhs, const CompactSpinConfiguration& rhs) {
+                return !(lhs == rhs);
+            }
+
+        private:
+
+            /**
+             * @brief time points of all the sites
+             */
+            std::vector<TimeType> _times;
+
+            /**
+             * @brief _offsets[i] is the index of the first time point at ith site in _times
+             */
+            std::vector<std::size_t> _offsets;
+
+            /**
+             * @brief bit-packed spin values, the bit is set for +1
+             */
+            std::vector<Word> _spins;
+        };
+
+    } // namespace system
+} // namespace openjij
+
+#endif
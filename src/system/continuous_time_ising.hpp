@@ -18,10 +18,13 @@
 #include <system/system.hpp>
 #include <graph/all.hpp>
 #include <cassert>
+#include <cstdint>
 #include <vector>
 #include <utility>
 
+#include <system/compact_spin_configuration.hpp>
 #include <utility/eigen.hpp>
+#include <utility/union_find.hpp>
 
 namespace openjij {
     namespace system {
@@ -54,11 +57,63 @@ namespace openjij {
             using SparseMatrixXx = Eigen::SparseMatrix<FloatType, Eigen::RowMajor>;
 
             /**
-             * @brief spin configuration in real and continuous time space
+             * @brief spin configuration in real and continuous time space (used to give and take configurations)
              * spin_config[i][j] -> at i th site, j th pair of imaginary time point and spin value after the point
              */
             using SpinConfiguration = std::vector<std::vector<CutPoint>>;
 
+            /**
+             * @brief spin configuration stored as structure of arrays (the storage of the system)
+             */
+            using CompactConfiguration = CompactSpinConfiguration<TimeType>;
+
+            /**
+             * @brief buffers reused by the updaters across sweeps (not a part of the spin state)
+             */
+            struct Workspace {
+                /**
+                 * @brief poisson points (cuts or bonds) generated in the current step
+                 */
+                std::vector<TimeType> poisson_points;
+
+                /**
+                 * @brief spare spin configuration, into which the timelines are rebuilt and then swapped with spin_config
+                 */
+                CompactConfiguration spin_config;
+
+                /**
+                 * @brief union-find tree over all the time segments
+                 */
+                utility::UnionFind union_find_tree{0};
+
+                /**
+                 * @brief flip decision for each cluster root (-1: undecided, 0: keep, 1: flip)
+                 */
+                std::vector<std::int8_t> flip_decision;
+
+                /* buffers for the multi-threaded updater */
+
+                /**
+                 * @brief union-find tree shared by threads
+                 */
+                utility::ConcurrentUnionFind concurrent_union_find_tree{0};
+
+                /**
+                 * @brief seeds of the random number engines for each work item
+                 */
+                std::vector<std::uint64_t> seeds;
+
+                /**
+                 * @brief poisson points for each thread
+                 */
+                std::vector<std::vector<TimeType>> thread_poisson_points;
+
+                /**
+                 * @brief timelines of each block of sites, rebuilt by a thread and then concatenated
+                 */
+                std::vector<CompactConfiguration> block_spin_configs;
+            };
+
             /**
              * @brief ContinuousTimeIsing constructor
              *
@@ -93,7 +148,8 @@ namespace openjij {
 
                 interaction += diag;
 
-                spin_config.push_back(std::vector<CutPoint> { CutPoint(0.0, 1) });
+                spin_config.append(TimeType(), 1);
+                spin_config.close_site();
                 // initialize auxiliary spin with 1 along entire timeline
             }
 
@@ -144,8 +200,9 @@ namespace openjij {
             void reset_spins(const SpinConfiguration& init_spin_config) {
                 assert(init_spin_config.size() == this->num_spins-1);
 
-                this->spin_config = init_spin_config;
-                this->spin_config.push_back(std::vector<CutPoint> { CutPoint(TimeType(), 1) });
+                this->spin_config.assign(init_spin_config);
+                this->spin_config.append(TimeType(), 1);
+                this->spin_config.close_site();
                 // add auxiliary timeline
             }
 
@@ -157,12 +214,20 @@ namespace openjij {
             void reset_spins(const graph::Spins& classical_spins) {
                 assert(classical_spins.size() == this->num_spins-1);
 
+                this->spin_config.clear();
                 for(size_t i = 0;i < this->num_spins - 1;i++) {
-                    this->spin_config[i] = std::vector<CutPoint> {
-                        CutPoint(TimeType(), classical_spins[i]) // TimeType() is zero value of the type
-                    };
+                    this->spin_config.append(TimeType(), classical_spins[i]); // TimeType() is zero value of the type
+                    this->spin_config.close_site();
                 }
-                this->spin_config[this->num_spins-1] = std::vector<CutPoint> { CutPoint(TimeType(), 1) };
+                this->spin_config.append(TimeType(), 1);
+                this->spin_config.close_site();
+            }
+
+            /**
+             * @brief spin configuration (including the auxiliary one) converted from spin_config
+             */
+            SpinConfiguration get_spin_config() const {
+                return this->spin_config.to_spin_configuration();
             }
 
             /**
@@ -173,23 +238,7 @@ namespace openjij {
              * @param time_point time-direction point
              */
             size_t get_temporal_spin_index(graph::Index site_index, TimeType time_point) const {
-                static const auto first_lt = [](CutPoint x, CutPoint y) { return x.first < y.first; };
-                // function to compare two time points (lt; less than)
-
-                const auto& timeline = this->spin_config[site_index];
-                const auto dummy_cut = CutPoint(time_point, 0); // dummy variable for binary search
-                auto found_itr = std::upper_bound(timeline.begin(),
-                                                  timeline.end(),
-                                                  dummy_cut,
-                                                  first_lt);
-
-                if(found_itr == timeline.begin()) { // if the time_point lies before any time points
-                    found_itr = timeline.end() - 1; // periodic boundary condition
-                } else {
-                    found_itr--;
-                }
-
-                return std::distance(timeline.begin(), found_itr);
+                return this->spin_config.get_temporal_spin_index(site_index, time_point);
             }
 
             /*
@@ -200,9 +249,9 @@ namespace openjij {
             graph::Spins get_slice_at(TimeType slice_time) const {
                 graph::Spins slice;
 
-                for(graph::Index i = 0;i < this->spin_config.size()-1;i++) {
+                for(graph::Index i = 0;i < this->spin_config.num_sites()-1;i++) {
                     auto temporal_index = get_temporal_spin_index(i, slice_time);
-                    slice.push_back(this->spin_config[i][temporal_index].second);
+                    slice.push_back(this->spin_config.spin(i, temporal_index));
                 }
 
                 return slice;
@@ -214,18 +263,19 @@ namespace openjij {
              * @param slice_time
              */
             graph::Spin get_auxiliary_spin(TimeType slice_time) const {
-                auto last_index = this->spin_config.size()-1;
+                auto last_index = this->spin_config.num_sites()-1;
                 auto temporal_index = get_temporal_spin_index(last_index, slice_time);
-                return this->spin_config[last_index][temporal_index].second;
+                return this->spin_config.spin(last_index, temporal_index);
             }
 
 
             /* Member variables */
 
             /**
-             * @brief spin configuration
+             * @brief spin configuration; the cut times of all the sites are in one contiguous array and the spins are bit-packed
+             * (use get_spin_config and reset_spins to take and give SpinConfiguration)
              */
-            SpinConfiguration spin_config;
+            CompactConfiguration spin_config;
 
             /**
              * @brief number of spins, including auxiliary spin for longitudinal magnetic field
@@ -241,6 +291,11 @@ namespace openjij {
              * @brief coefficient of transverse field term, actual field would be gamma * s, where s = [0:1]
              */
             const FloatType gamma;
+
+            /**
+             * @brief buffers for updaters
+             */
+            Workspace workspace;
         };
 
         /**
@@ -0,0 +1,294 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_SYSTEM_OBSERVABLES_HPP__
+#define OPENJIJ_SYSTEM_OBSERVABLES_HPP__
+
+#include <cstddef>
+#include <vector>
+
+namespace openjij {
+    namespace system {
+
+        /**
+         * @brief observables of a classical system maintained by the updaters
+         *
+         * @details updaters report each trial by accept (with the differences of energy and magnetization) or reject,
+         * so the observables are kept up to date in O(1) per trial.
+         * updaters which change many spins at once (e.g. cluster updates) call set with recomputed values instead.
+         *
+         * @tparam FloatType
+         */
+        template<typename FloatType>
+        struct Observables {
+
+            /**
+             * @brief reset all the observables, the acceptance counts and the best energy
+             *
+             * @param init_energy
+             * @param init_magnetization
+             */
+            void reset(FloatType init_energy, FloatType init_magnetization) {
+                energy = init_energy;
+                magnetization = init_magnetization;
+                best_energy = init_energy;
+                num_accepted = 0;
+                num_rejected = 0;
+            }
+
+            /**
+             * @brief set recomputed energy and magnetization (the acceptance counts are not changed)
+             *
+             * @param new_energy
+             * @param new_magnetization
+             *
+             * @return true if the best energy is updated
+             */
+            bool set(FloatType new_energy, FloatType new_magnetization) {
+                energy = new_energy;
+                magnetization = new_magnetization;
+                return update_best_energy();
+            }
+
+            /**
+             * @brief record an accepted flip
+             *
+             * @param dE energy difference
+             * @param dM magnetization difference
+             *
+             * @return true if the best energy is updated
+             */
+            bool accept(FloatType dE, FloatType dM) {
+                energy += dE;
+                magnetization += dM;
+                ++num_accepted;
+                return update_best_energy();
+            }
+
+            /**
+             * @brief record accepted flips at once without changing the energy and the magnetization
+             * (e.g. for cluster updaters, which call set with recomputed values)
+             *
+             * @param count number of accepted flips
+             */
+            void accept(std::size_t count) {
+                num_accepted += count;
+            }
+
+            /**
+             * @brief record a rejected flip
+             */
+            void reject() {
+                ++num_rejected;
+            }
+
+            /**
+             * @brief record rejected flips at once (e.g. for rejection-free updaters)
+             *
+             * @param count number of rejected flips
+             */
+            void reject(std::size_t count) {
+                num_rejected += count;
+            }
+
+            /**
+             * @brief ratio of accepted flips to all the trials (0 if no trial)
+             */
+            FloatType acceptance_ratio() const {
+                const std::size_t num_trials = num_accepted + num_rejected;
+                return (num_trials == 0) ? FloatType(0) : FloatType(num_accepted) / num_trials;
+            }
+
+            /**
+             * @brief current energy
+             */
+            FloatType energy = 0;
+
+            /**
+             * @brief current magnetization (sum of the spins)
+             */
+            FloatType magnetization = 0;
+
+            /**
+             * @brief the lowest energy since the last reset
+             */
+            FloatType best_energy = 0;
+
+            /**
+             * @brief number of accepted flips since the last reset
+             */
+            std::size_t num_accepted = 0;
+
+            /**
+             * @brief number of rejected flips since the last reset
+             */
+            std::size_t num_rejected = 0;
+
+        private:
+            bool update_best_energy() {
+                if(energy < best_energy) {
+                    best_energy = energy;
+                    return true;
+                }
+                return false;
+            }
+        };
+
+        /**
+         * @brief keeps the spin configuration with the lowest energy
+         *
+         * @details the flips after the last snapshot are journaled, and the snapshot is brought up to date by replaying them
+         * only when a new minimum is reached. if the journal gets longer than the number of spins,
+         * the snapshot is copied from the current spins instead. thus the cost is O(1) per flip on average.
+         *
+         * @tparam SpinVector type of spins (Eigen vector)
+         */
+        template<typename SpinVector>
+        struct BestSpinTracker {
+
+            /**
+             * @brief take the current spins as the best ones
+             *
+             * @param spin current spins
+             */
+            void reset(const SpinVector& spin) {
+                best_spin = spin;
+                journal.clear();
+                out_of_sync = false;
+            }
+
+            /**
+             * @brief record a flip of the current spins
+             *
+             * @param index index of the flipped spin
+             */
+            void flipped(std::size_t index) {
+                if(out_of_sync) {
+                    return;
+                }
+                if(journal.size() < static_cast<std::size_t>(best_spin.size())) {
+                    journal.push_back(index);
+                }
+                else {
+                    invalidate();
+                }
+            }
+
+            /**
+             * @brief record that many spins are changed at once (the journal is discarded)
+             */
+            void invalidate() {
+                journal.clear();
+                out_of_sync = true;
+            }
+
+            /**
+             * @brief a new minimum is reached by the current spins
+             *
+             * @param spin current spins
+             */
+            void improved(const SpinVector& spin) {
+                if(out_of_sync) {
+                    reset(spin);
+                    return;
+                }
+                for(const auto index : journal) {
+                    best_spin(index) *= -1;
+                }
+                journal.clear();
+            }
+
+            /**
+             * @brief spins with the lowest energy since the last reset
+             */
+            SpinVector best_spin;
+
+        private:
+            std::vector<std::size_t> journal;
+            bool out_of_sync = false;
+        };
+
+        /**
+         * @brief history of observables, to be used as an observer of algorithm::Algorithm::run
+         *
+         * @details each record holds the observables at the time of the call,
+         * and the acceptance ratio of the trials since the previous record.
+         *
+         * @tparam FloatType
+         */
+        template<typename FloatType>
+        struct ObservablesHistory {
+
+            /**
+             * @brief record the observables of the system
+             *
+             * @param system system which has observables (e.g. ClassicalIsing)
+             * @param parameter updater parameter (not used)
+             */
+            template<typename System, typename UpdaterParameter>
+            void operator()(const System& system, const UpdaterParameter&) {
+                record(system.observables);
+            }
+
+            /**
+             * @brief record observables
+             *
+             * @param observables
+             */
+            void record(const Observables<FloatType>& observables) {
+                // the counts are reset by the system, start over in that case
+                if(observables.num_accepted < last_accepted || observables.num_rejected < last_rejected) {
+                    last_accepted = 0;
+                    last_rejected = 0;
+                }
+                const std::size_t accepted = observables.num_accepted - last_accepted;
+                const std::size_t trials = accepted + (observables.num_rejected - last_rejected);
+                last_accepted = observables.num_accepted;
+                last_rejected = observables.num_rejected;
+
+                energy.push_back(observables.energy);
+                magnetization.push_back(observables.magnetization);
+                best_energy.push_back(observables.best_energy);
+                acceptance_ratio.push_back((trials == 0) ? FloatType(0) : FloatType(accepted) / trials);
+            }
+
+            /**
+             * @brief energy at each record
+             */
+            std::vector<FloatType> energy;
+
+            /**
+             * @brief magnetization at each record
+             */
+            std::vector<FloatType> magnetization;
+
+            /**
+             * @brief the lowest energy until each record
+             */
+            std::vector<FloatType> best_energy;
+
+            /**
+             * @brief acceptance ratio between the previous record and each record
+             */
+            std::vector<FloatType> acceptance_ratio;
+
+        private:
+            std::size_t last_accepted = 0;
+            std::size_t last_rejected = 0;
+        };
+
+    } // namespace system
+} // namespace openjij
+
+#endif
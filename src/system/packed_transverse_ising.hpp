@@ -0,0 +1,284 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_SYSTEM_PACKED_TRANSVERSE_ISING_HPP__
+#define OPENJIJ_SYSTEM_PACKED_TRANSVERSE_ISING_HPP__
+
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include <system/system.hpp>
+#include <system/transverse_ising.hpp>
+#include <graph/all.hpp>
+#include <utility/eigen.hpp>
+
+namespace openjij {
+    namespace system {
+
+        /**
+         * @brief TransverseIsing structure whose trotter spins are packed into bits
+         *
+         * @tparam GraphType
+         */
+        template<typename GraphType>
+            struct PackedTransverseIsing;
+
+        /**
+         * @brief Sparse TransverseIsing structure whose trotter spins are packed into bits.
+         * The Hamiltonian is the same as TransverseIsing<graph::Sparse<FloatType>>.
+         *
+         * The trotter spins of ith site are stored in num_words consecutive 64bit words,
+         * where the bit t%64 of the word t/64 is set if the spin in tth trotter slice is +1.
+         * The bits after the last trotter slice are always zero.
+         *
+         * @tparam FloatType
+         */
+        template<typename FloatType>
+            struct PackedTransverseIsing<graph::Sparse<FloatType>> {
+                using system_type = transverse_field_system;
+
+                //matrix (row major)
+                using SparseMatrixXx = Eigen::SparseMatrix<FloatType, Eigen::RowMajor>;
+
+                //word of packed spins
+                using Word = std::uint64_t;
+
+                static constexpr std::size_t word_bits = 64;
+
+                /**
+                 * @brief PackedTransverseIsing Constructor
+                 *
+                 * @param init_trotter_spins
+                 * @param init_interaction
+                 * @param gamma
+                 */
+                PackedTransverseIsing(const TrotterSpins& init_trotter_spins, const graph::Sparse<FloatType>& init_interaction, double gamma)
+                :interaction(utility::gen_matrix_from_graph<Eigen::RowMajor>(init_interaction)),
+                num_classical_spins(init_trotter_spins[0].size()),
+                num_trotter_slices(init_trotter_spins.size()),
+                num_words((init_trotter_spins.size()+word_bits-1)/word_bits),
+                gamma(gamma){
+                    if(!(init_trotter_spins.size() >= 2)){
+                        throw std::invalid_argument("trotter slices must be equal or larger than 2.");
+                    }
+                    reset_spins(init_trotter_spins);
+                }
+
+                /**
+                 * @brief PackedTransverseIsing Constuctor with initial classical spins
+                 *
+                 * @param init_classical_spins initial classical spins
+                 * @param init_interaction
+                 * @param gamma
+                 * @param num_trotter_slices
+                 */
+                PackedTransverseIsing(const graph::Spins& init_classical_spins, const graph::Sparse<FloatType>& init_interaction, double gamma, size_t num_trotter_slices)
+                :interaction(utility::gen_matrix_from_graph<Eigen::RowMajor>(init_interaction)),
+                num_classical_spins(init_classical_spins.size()),
+                num_trotter_slices(num_trotter_slices),
+                num_words((num_trotter_slices+word_bits-1)/word_bits),
+                gamma(gamma){
+                    if(!(num_trotter_slices >= 2)){
+                        throw std::invalid_argument("trotter slices must be equal or larger than 2.");
+                    }
+                    reset_spins(init_classical_spins);
+                }
+
+                /**
+                 * @brief reset spins with trotter spins
+                 *
+                 * @param init_trotter_spins
+                 */
+                void reset_spins(const TrotterSpins& init_trotter_spins){
+                    assert(init_trotter_spins.size() == num_trotter_slices);
+                    packed_spins.assign(num_classical_spins*num_words, 0);
+                    for(std::size_t t=0; t<num_trotter_slices; t++){
+                        for(std::size_t i=0; i<num_classical_spins; i++){
+                            set_spin(i, t, init_trotter_spins[t][i]);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief reset spins with classical spins (the same in all the trotter slices)
+                 *
+                 * @param classical_spins
+                 */
+                void reset_spins(const graph::Spins& classical_spins){
+                    reset_spins(TrotterSpins(num_trotter_slices, classical_spins));
+                }
+
+                /**
+                 * @brief get trotter spins
+                 *
+                 * @return trotter spins (trotter_spins[t][i] -> ith spin in tth trotter slice)
+                 */
+                TrotterSpins get_trotter_spins() const {
+                    TrotterSpins trotter_spins(num_trotter_slices, graph::Spins(num_classical_spins));
+                    for(std::size_t t=0; t<num_trotter_slices; t++){
+                        for(std::size_t i=0; i<num_classical_spins; i++){
+                            trotter_spins[t][i] = spin(i, t);
+                        }
+                    }
+                    return trotter_spins;
+                }
+
+                /**
+                 * @brief spin of ith site in tth trotter slice
+                 */
+                graph::Spin spin(std::size_t index, std::size_t index_trot) const {
+                    return ((words(index)[index_trot/word_bits] >> (index_trot%word_bits)) & 1) ? 1 : -1;
+                }
+
+                /**
+                 * @brief set spin of ith site in tth trotter slice
+                 */
+                void set_spin(std::size_t index, std::size_t index_trot, graph::Spin value){
+                    const Word mask = Word(1) << (index_trot%word_bits);
+                    Word& word = words(index)[index_trot/word_bits];
+                    word = (value > 0) ? (word | mask) : (word & ~mask);
+                }
+
+                /**
+                 * @brief packed trotter spins of ith site (num_words words)
+                 */
+                Word* words(std::size_t index){
+                    return packed_spins.data() + index*num_words;
+                }
+
+                /**
+                 * @brief packed trotter spins of ith site (num_words words)
+                 */
+                const Word* words(std::size_t index) const {
+                    return packed_spins.data() + index*num_words;
+                }
+
+                /**
+                 * @brief number of kinks (pairs of neighboring trotter slices with different spins) at ith site
+                 */
+                std::size_t num_kinks(std::size_t index) const {
+                    std::size_t kinks = 0;
+                    const Word* x = words(index);
+                    for(std::size_t w=0; w<num_words; w++){
+                        kinks += std::bitset<word_bits>((x[w] ^ next_slice(x, w)) & valid_mask(w)).count();
+                    }
+                    return kinks;
+                }
+
+                /**
+                 * @brief mask of the bits representing trotter slices in wth word
+                 */
+                Word valid_mask(std::size_t w) const {
+                    const std::size_t rest = num_trotter_slices - w*word_bits;
+                    return (rest >= word_bits) ? ~Word(0) : ((Word(1) << rest) - 1);
+                }
+
+                /**
+                 * @brief wth word of the spins in the next trotter slices, i.e. the bit t holds the spin in (t+1)th slice (periodic)
+                 */
+                Word next_slice(const Word* x, std::size_t w) const {
+                    Word next = x[w] >> 1;
+                    if(w+1 < num_words){
+                        next |= x[w+1] << (word_bits-1);
+                    }
+                    const std::size_t last = num_trotter_slices-1;
+                    if(w == last/word_bits){
+                        next = (next & ~(Word(1) << (last%word_bits))) | ((x[0] & 1) << (last%word_bits));
+                    }
+                    return next;
+                }
+
+                /**
+                 * @brief wth word of the spins in the previous trotter slices, i.e. the bit t holds the spin in (t-1)th slice (periodic)
+                 */
+                Word prev_slice(const Word* x, std::size_t w) const {
+                    Word prev = x[w] << 1;
+                    if(w > 0){
+                        prev |= x[w-1] >> (word_bits-1);
+                    }
+                    else{
+                        const std::size_t last = num_trotter_slices-1;
+                        prev |= (x[last/word_bits] >> (last%word_bits)) & 1;
+                    }
+                    return prev & valid_mask(w);
+                }
+
+                /**
+                 * @brief packed trotter spins of all the sites
+                 */
+                std::vector<Word> packed_spins;
+
+                /**
+                 * @brief interaction
+                 */
+                const SparseMatrixXx interaction;
+
+                /**
+                 * @brief number of real classical spins (dummy spin excluded)
+                 */
+                const std::size_t num_classical_spins;
+
+                /**
+                 * @brief number of trotter slices
+                 */
+                const std::size_t num_trotter_slices;
+
+                /**
+                 * @brief number of words per site
+                 */
+                const std::size_t num_words;
+
+                /**
+                 * @brief coefficient of transverse field term
+                 */
+                FloatType gamma;
+            };
+
+        /**
+         * @brief helper function for PackedTransverseIsing constructor
+         *
+         * @tparam GraphType
+         * @param init_trotter_spins
+         * @param init_interaction
+         * @param gamma
+         *
+         * @return generated object
+         */
+        template<typename GraphType>
+            auto make_packed_transverse_ising(const TrotterSpins& init_trotter_spins, const GraphType& init_interaction, double gamma){
+                return PackedTransverseIsing<GraphType>(init_trotter_spins, init_interaction, gamma);
+            }
+
+        /**
+         * @brief helper function for PackedTransverseIsing constructor
+         *
+         * @tparam GraphType
+         * @param classical_spins
+         * @param init_interaction
+         * @param gamma
+         * @param num_trotter_slices
+         *
+         * @return generated object
+         */
+        template<typename GraphType>
+            auto make_packed_transverse_ising(const graph::Spins& classical_spins, const GraphType& init_interaction, double gamma, std::size_t num_trotter_slices){
+                return PackedTransverseIsing<GraphType>(classical_spins, init_interaction, gamma, num_trotter_slices);
+            }
+    } // namespace system
+} // namespace openjij
+
+#endif
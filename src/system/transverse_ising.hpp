@@ -59,6 +59,8 @@ namespace openjij {
                 using MatrixXx = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
                 //trotter matrix (col major)
                 using TrotterMatrix = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+                //energy of each trotter slice
+                using SliceEnergy = Eigen::Matrix<FloatType, Eigen::Dynamic, 1>;
 
                 /**
                  * @brief TransverseIsing Constructor
@@ -73,6 +75,7 @@ namespace openjij {
                     if(!(init_trotter_spins.size() >= 2)){
                         throw std::invalid_argument("trotter slices must be equal or larger than 2.");
                     }
+                    reset_local_field();
                 }
 
                 /**
@@ -99,6 +102,7 @@ namespace openjij {
 
                     //init trotter_spins
                     trotter_spins = utility::gen_matrix_from_trotter_spins<FloatType, Eigen::ColMajor>(init_trotter_spins);
+                    reset_local_field();
                 }
 
                 /**
@@ -108,6 +112,7 @@ namespace openjij {
                  */
                 void reset_spins(const TrotterSpins& init_trotter_spins){
                     this->trotter_spins = utility::gen_matrix_from_trotter_spins<FloatType, Eigen::ColMajor>(init_trotter_spins);
+                    reset_local_field();
                 }
                 
                 /**
@@ -123,6 +128,38 @@ namespace openjij {
                     }
                     //init trotter_spins
                     this->trotter_spins = utility::gen_matrix_from_trotter_spins<FloatType, Eigen::ColMajor>(init_trotter_spins);
+                    reset_local_field();
+                }
+
+                /**
+                 * @brief recalculate local fields (and slice energies) from trotter spins.
+                 * call this after trotter_spins is modified directly.
+                 */
+                void reset_local_field(){
+                    this->local_field = this->interaction * this->trotter_spins;
+                    reset_slice_energy();
+                    this->num_incremental_flips = 0;
+                }
+
+                /**
+                 * @brief recalculate local fields (and slice energies) after max_incremental_flips_per_spin flips per trotter spin,
+                 * so that rounding errors of the incremental updates do not accumulate. the updaters call this at the beginning of each update.
+                 *
+                 * @return true if recalculated
+                 */
+                bool synchronize_local_field(){
+                    if(this->num_incremental_flips <= max_incremental_flips_per_spin * this->num_classical_spins * static_cast<std::size_t>(this->trotter_spins.cols())){
+                        return false;
+                    }
+                    reset_local_field();
+                    return true;
+                }
+
+                /**
+                 * @brief recalculate classical energies of trotter slices from trotter spins and local fields
+                 */
+                void reset_slice_energy(){
+                    this->slice_energy = ((this->trotter_spins.cwiseProduct(this->local_field).colwise().sum().transpose().array() - 1) / 2).matrix();
                 }
 
                 /**
@@ -130,6 +167,16 @@ namespace openjij {
                  */
                 TrotterMatrix trotter_spins;
 
+                /**
+                 * @brief local fields in each trotter slice (interaction * trotter_spins), updated by updaters on every flip
+                 */
+                TrotterMatrix local_field;
+
+                /**
+                 * @brief classical energy of each trotter slice, updated by updaters on every flip
+                 */
+                SliceEnergy slice_energy;
+
                 /**
                  * @brief interaction 
                  */
@@ -144,6 +191,21 @@ namespace openjij {
                  * @brief coefficient of transverse field term
                  */
                 FloatType gamma;
+
+                /**
+                 * @brief number of worldline moves per classical spin tried in each SingleSpinFlip or ParallelSingleSpinFlip update (0: local moves only)
+                 */
+                FloatType worldline_flip_ratio = 0;
+
+                /**
+                 * @brief number of flips applied incrementally to local_field and slice_energy since they were recalculated
+                 */
+                std::size_t num_incremental_flips = 0;
+
+                /**
+                 * @brief local fields are recalculated after this number of incremental flips per trotter spin (see synchronize_local_field)
+                 */
+                static constexpr std::size_t max_incremental_flips_per_spin = 100;
             };
 
         /**
@@ -166,6 +228,8 @@ namespace openjij {
                 using SparseMatrixXx = Eigen::SparseMatrix<FloatType, Eigen::RowMajor>;
                 //trotter matrix (col major)
                 using TrotterMatrix = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+                //energy of each trotter slice
+                using SliceEnergy = Eigen::Matrix<FloatType, Eigen::Dynamic, 1>;
 
                 /**
                  * @brief TransverseIsing Constructor
@@ -180,6 +244,7 @@ namespace openjij {
                     if(!(init_trotter_spins.size() >= 2)){
                         throw std::invalid_argument("trotter slices must be equal or larger than 2.");
                     }
+                    reset_local_field();
                 }
 
                 /**
@@ -207,6 +272,7 @@ namespace openjij {
 
                     //init trotter_spins
                     trotter_spins = utility::gen_matrix_from_trotter_spins<FloatType, Eigen::ColMajor>(init_trotter_spins);
+                    reset_local_field();
                 }
 
                 /**
@@ -216,6 +282,7 @@ namespace openjij {
                  */
                 void reset_spins(const TrotterSpins& init_trotter_spins){
                     this->trotter_spins = utility::gen_matrix_from_trotter_spins<FloatType, Eigen::ColMajor>(init_trotter_spins);
+                    reset_local_field();
                 }
                 
                 /**
@@ -231,12 +298,54 @@ namespace openjij {
                     }
                     //init trotter_spins
                     this->trotter_spins = utility::gen_matrix_from_trotter_spins<FloatType, Eigen::ColMajor>(init_trotter_spins);
+                    reset_local_field();
+                }
+
+                /**
+                 * @brief recalculate local fields (and slice energies) from trotter spins.
+                 * call this after trotter_spins is modified directly.
+                 */
+                void reset_local_field(){
+                    this->local_field = this->interaction * this->trotter_spins;
+                    reset_slice_energy();
+                    this->num_incremental_flips = 0;
+                }
+
+                /**
+                 * @brief recalculate local fields (and slice energies) after max_incremental_flips_per_spin flips per trotter spin,
+                 * so that rounding errors of the incremental updates do not accumulate. the updaters call this at the beginning of each update.
+                 *
+                 * @return true if recalculated
+                 */
+                bool synchronize_local_field(){
+                    if(this->num_incremental_flips <= max_incremental_flips_per_spin * this->num_classical_spins * static_cast<std::size_t>(this->trotter_spins.cols())){
+                        return false;
+                    }
+                    reset_local_field();
+                    return true;
+                }
+
+                /**
+                 * @brief recalculate classical energies of trotter slices from trotter spins and local fields
+                 */
+                void reset_slice_energy(){
+                    this->slice_energy = ((this->trotter_spins.cwiseProduct(this->local_field).colwise().sum().transpose().array() - 1) / 2).matrix();
                 }
                 /**
                  * @brief trotterlized spins
                  */
                 TrotterMatrix trotter_spins;
 
+                /**
+                 * @brief local fields in each trotter slice (interaction * trotter_spins), updated by updaters on every flip
+                 */
+                TrotterMatrix local_field;
+
+                /**
+                 * @brief classical energy of each trotter slice, updated by updaters on every flip
+                 */
+                SliceEnergy slice_energy;
+
                 /**
                  * @brief interaction 
                  */
@@ -251,6 +360,21 @@ namespace openjij {
                  * @brief coefficient of transverse field term
                  */
                 FloatType gamma;
+
+                /**
+                 * @brief number of worldline moves per classical spin tried in each SingleSpinFlip or ParallelSingleSpinFlip update (0: local moves only)
+                 */
+                FloatType worldline_flip_ratio = 0;
+
+                /**
+                 * @brief number of flips applied incrementally to local_field and slice_energy since they were recalculated
+                 */
+                std::size_t num_incremental_flips = 0;
+
+                /**
+                 * @brief local fields are recalculated after this number of incremental flips per trotter spin (see synchronize_local_field)
+                 */
+                static constexpr std::size_t max_incremental_flips_per_spin = 100;
             };
 
         /**
@@ -19,8 +19,12 @@
 #include <utility/disable_eigen_warning.hpp>
 
 #include <updater/single_spin_flip.hpp>
+#include <updater/parallel_single_spin_flip.hpp>
 #include <updater/swendsen_wang.hpp>
 #include <updater/continuous_time_swendsen_wang.hpp>
+#include <updater/parallel_continuous_time_swendsen_wang.hpp>
+#include <updater/houdayer.hpp>
+#include <updater/n_fold_way.hpp>
 
 #ifdef USE_CUDA
 #include <updater/gpu.hpp>
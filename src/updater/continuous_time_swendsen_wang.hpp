@@ -20,7 +20,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cassert>
-#include <unordered_map>
 
 #include <graph/all.hpp>
 #include <system/continuous_time_ising.hpp>
@@ -60,27 +59,29 @@ namespace openjij {
                                const utility::TransverseFieldUpdaterParameter& parameter) {
 
                 const graph::Index num_spin = system.num_spins;
-                std::vector<graph::Index> index_helper;
-                index_helper.reserve(num_spin+1);
-                index_helper.push_back(0);
-                /* index_helper[i]+k gives 1 dimensionalized index of kth time point at ith site.
-                 * this helps use of union-find tree only available for 1D structure.
-                 */
+                auto& workspace = system.workspace;
 
-                /* 1. remove old cuts and place new cuts for every site */
+                /* 1. remove old cuts and place new cuts for every site.
+                 * the timelines are rebuilt into the spare configuration, which is swapped with spin_config.
+                 * spin_config.offset(i)+k gives 1 dimensionalized index of kth time point at ith site,
+                 * which helps use of union-find tree only available for 1D structure.
+                 */
+                auto& cuts = workspace.poisson_points;
+                auto& new_spin_config = workspace.spin_config;
+                new_spin_config.clear();
                 for(graph::Index i = 0;i < num_spin;i++) {
-                    auto& timeline = system.spin_config[i];
-                    auto cuts = generate_poisson_points(0.5*system.gamma*(1.0-parameter.s), parameter.beta, random_number_engine);
+                    generate_poisson_points(0.5*system.gamma*(1.0-parameter.s), parameter.beta, random_number_engine, cuts);
                     // assuming transverse field gamma is positive
 
-                    timeline = create_timeline(timeline, cuts);
-                    assert(timeline.size() > 0);
-
-                    index_helper.push_back(index_helper.back()+timeline.size());
+                    create_timeline(system.spin_config, i, cuts, new_spin_config);
                 }
+                system.spin_config.swap(new_spin_config);
+                const auto& spin_config = system.spin_config;
 
                 /* 2. place spacial bonds */
-                utility::UnionFind union_find_tree(index_helper.back());
+                auto& union_find_tree = workspace.union_find_tree;
+                union_find_tree.reset(spin_config.offset(num_spin));
+                auto& bonds = workspace.poisson_points;
                 for(graph::Index i = 0;i < num_spin;i++) {
                     for(typename CTIsing::SparseMatrixXx::InnerIterator it(system.interaction, i); it; ++it) {
                         std::size_t j = it.index();
@@ -90,117 +91,142 @@ namespace openjij {
                                       // if adj_nodes are sorted, this "continue" can be replaced by "break"
                         }
 
-                        const auto bonds = generate_poisson_points(std::abs(0.5*J*parameter.s),
-                                                                   parameter.beta, random_number_engine);
-                        for(const auto bond : bonds) {
-                            /* get time point indices just before the bond */
-                            auto ki = system.get_temporal_spin_index(i, bond);
-                            auto kj = system.get_temporal_spin_index(j, bond);
-
-                            if(system.spin_config[i][ki].second * system.spin_config[j][kj].second * J < 0) {
-                                union_find_tree.unite_sets(index_helper[i]+ki, index_helper[j]+kj);
-                            }
-                        }
+                        generate_poisson_points(std::abs(0.5*J*parameter.s),
+                                                parameter.beta, random_number_engine, bonds);
+                        place_bonds(spin_config, i, j, J, bonds, union_find_tree);
                     }
                 }
 
-                /* 3. make clusters */
-                std::unordered_map<utility::UnionFind::Node, std::vector<utility::UnionFind::Node>> cluster_map;
-                // root-index to {contained nodes} map
-
-                for(graph::Index i = 0;i < num_spin;i++) {
-                    for(size_t k = 0;k < system.spin_config[i].size();k++) {
-                        auto index = index_helper[i] + k;
-                        auto root_index = union_find_tree.find_set(index);
-                        auto position = cluster_map.find(root_index);
-                        if(position == cluster_map.end()) {
-                            cluster_map.emplace(root_index, std::vector<utility::UnionFind::Node>{ index });
-                        } else {
-                            position->second.push_back(index);
-                        }
-                    }
-                }
+                /* 3. flip clusters
+                 * the flip of each cluster is decided (with the probability 1/2) when its root is visited first.
+                 */
+                auto& flip_decision = workspace.flip_decision;
+                const std::size_t num_nodes = spin_config.offset(num_spin);
+                flip_decision.assign(num_nodes, -1);
 
-                /* 4. flip clusters */
                 auto urd = std::uniform_real_distribution<>(0, 1.0);
-                for(const auto& cluster : cluster_map) {
-                    // 4.1. decide spin state (flip with the probability 1/2)
-                    const FloatType probability = 1.0 / 2.0;
-                    if(urd(random_number_engine) < probability){
-                        // 4.2. update spin states
-                        for(auto node : cluster.second) {
-                            auto i = std::distance(index_helper.begin(),
-                                                   std::upper_bound(index_helper.begin(), index_helper.end(), node)) - 1;
-                            auto k = node - index_helper[i];
-                            system.spin_config[i][k].second *= -1;
-                        }
+                const FloatType probability = 1.0 / 2.0;
+                for(std::size_t node = 0;node < num_nodes;node++) {
+                    auto root_index = union_find_tree.find_set(node);
+                    if(flip_decision[root_index] < 0) {
+                        flip_decision[root_index] = (urd(random_number_engine) < probability) ? 1 : 0;
+                    }
+                    if(flip_decision[root_index] == 1) {
+                        system.spin_config.flip_at(node);
                     }
                 }
             }
 
             /**
-             * @brief create new timeline; place kinks by ignoring old cuts and place new cuts
+             * @brief unite the time segments of ith and jth sites connected by the bonds
+             *
+             * @details bonds are sorted, so the time points just before them are found
+             * by sweeping cursors forward on both timelines
              *
+             * @param spin_config
+             * @param i
+             * @param j
+             * @param J interaction between ith and jth sites
+             * @param bonds sorted bonds
+             * @param union_find_tree union-find tree over 1 dimensionalized indices of spin_config (UnionFind or ConcurrentUnionFind)
              */
-            static std::vector<CutPoint> create_timeline(const std::vector<CutPoint>& old_timeline,
-                                                         const std::vector<TimeType>& cuts) {
-                /* remove redundant cuts*/
-                std::vector<CutPoint> concatenated_timeline;
-                auto current_spin = old_timeline.back().second;
-                for(auto cut_point : old_timeline) {
-                    if(cut_point.second != current_spin) {
-                        concatenated_timeline.push_back(cut_point);
-                    }
-                    current_spin = cut_point.second;
-                }
-
-                /* if entire timeline is occupied by single spin state */
-                std::vector<CutPoint> new_timeline;
-                if(concatenated_timeline.empty()) {
-                    if(cuts.empty()) {
-                        new_timeline.push_back(old_timeline[0]);
-                    } else {
-                        for(auto cut : cuts) {
-                            new_timeline.push_back(CutPoint(cut, current_spin));
-                        }
+            template<typename UnionFindTree>
+            static void place_bonds(const typename CTIsing::CompactConfiguration& spin_config,
+                                    std::size_t i, std::size_t j, FloatType J,
+                                    const std::vector<TimeType>& bonds,
+                                    UnionFindTree& union_find_tree) {
+                const auto times_i = spin_config.times(i);
+                const auto times_j = spin_config.times(j);
+                const std::size_t size_i = spin_config.size(i);
+                const std::size_t size_j = spin_config.size(j);
+                const std::size_t offset_i = spin_config.offset(i);
+                const std::size_t offset_j = spin_config.offset(j);
+                std::size_t cursor_i = 0;
+                std::size_t cursor_j = 0;
+                for(const auto bond : bonds) {
+                    /* get time point indices just before the bond */
+                    cursor_i = advance_cursor(times_i, size_i, cursor_i, bond);
+                    cursor_j = advance_cursor(times_j, size_j, cursor_j, bond);
+                    auto ki = (cursor_i == 0) ? size_i-1 : cursor_i-1;
+                    auto kj = (cursor_j == 0) ? size_j-1 : cursor_j-1; // periodic boundary condition
+
+                    if(spin_config.spin_at(offset_i+ki) * spin_config.spin_at(offset_j+kj) * J < 0) {
+                        union_find_tree.unite_sets(offset_i+ki, offset_j+kj);
                     }
-                    return new_timeline;
                 }
+            }
 
-                current_spin = concatenated_timeline.back().second;
-                auto timeline_itr = concatenated_timeline.begin();
-                auto cuts_itr = cuts.begin();
-                while(true) {
-                    /* if all cuts have been placed, add remaining old kinks and break loop */
-                    if(cuts_itr == cuts.end()) {
-                        std::for_each(timeline_itr, concatenated_timeline.end(), [&](CutPoint it) {
-                                new_timeline.push_back(it);
-                            });
-                        break;
-                    }
+            /**
+             * @brief move the cursor forward to the number of time points not later than time_point
+             *
+             * @details galloping (exponential then binary) search from the current cursor.
+             * a sweep over sorted time points costs O(min(n log m, n + m)) for n points on a timeline with m segments.
+             *
+             * @param times sorted time points of a timeline
+             * @param size number of the time points
+             * @param cursor number of time points not later than the previous (smaller or equal) time_point
+             * @param time_point
+             *
+             * @return new cursor
+             */
+            static std::size_t advance_cursor(const TimeType* times, std::size_t size, std::size_t cursor, TimeType time_point) {
+                return gallop(times, size, cursor, time_point, [](TimeType t) { return t; });
+            }
 
-                    /* if all spin kinks have been placed, add remaining cuts and break loop */
-                    if(timeline_itr == concatenated_timeline.end()) {
-                        std::for_each(cuts_itr, cuts.end(), [&](TimeType it) {
-                                new_timeline.push_back(CutPoint(it, current_spin));
-                            });
-                        break;
-                    }
+            /**
+             * @brief advance_cursor for a timeline of CutPoint
+             */
+            static std::size_t advance_cursor(const std::vector<CutPoint>& timeline, std::size_t cursor, TimeType time_point) {
+                return gallop(timeline.begin(), timeline.size(), cursor, time_point, [](const CutPoint& x) { return x.first; });
+            }
 
-                    /* add earlier of kink or cut to new timeline */
-                    if(*cuts_itr < timeline_itr->first) {
-                        new_timeline.push_back(CutPoint(*cuts_itr, current_spin));
-                        cuts_itr++;
-                    } else {
-                        new_timeline.push_back(*timeline_itr);
-                        current_spin = timeline_itr->second;
-                        timeline_itr++;
-                    }
-                }
+            /**
+             * @brief create new timeline of ith site; place kinks by ignoring old cuts and place new cuts
+             *
+             * @param old_spin_config
+             * @param site_index
+             * @param cuts sorted new cuts
+             * @param new_spin_config the new timeline is appended as a new site, must not alias old_spin_config
+             */
+            static void create_timeline(const typename CTIsing::CompactConfiguration& old_spin_config,
+                                        graph::Index site_index,
+                                        const std::vector<TimeType>& cuts,
+                                        typename CTIsing::CompactConfiguration& new_spin_config) {
+                merge_cuts(old_spin_config.size(site_index),
+                           [&](std::size_t k) { return CutPoint(old_spin_config.time(site_index, k), old_spin_config.spin(site_index, k)); },
+                           cuts,
+                           [&](const CutPoint& cut_point) { new_spin_config.append(cut_point.first, cut_point.second); });
+                new_spin_config.close_site();
+            }
 
+            /**
+             * @brief create new timeline; place kinks by ignoring old cuts and place new cuts
+             *
+             */
+            static std::vector<CutPoint> create_timeline(const std::vector<CutPoint>& old_timeline,
+                                                         const std::vector<TimeType>& cuts) {
+                std::vector<CutPoint> new_timeline;
+                create_timeline(old_timeline, cuts, new_timeline);
                 return new_timeline;
             }
 
+            /**
+             * @brief create new timeline into the given buffer (its capacity is reused)
+             *
+             * @param old_timeline
+             * @param cuts sorted new cuts
+             * @param new_timeline buffer to be overwritten, must not alias old_timeline
+             */
+            static void create_timeline(const std::vector<CutPoint>& old_timeline,
+                                        const std::vector<TimeType>& cuts,
+                                        std::vector<CutPoint>& new_timeline) {
+                new_timeline.clear();
+                merge_cuts(old_timeline.size(),
+                           [&](std::size_t k) { return old_timeline[k]; },
+                           cuts,
+                           [&](const CutPoint& cut_point) { new_timeline.push_back(cut_point); });
+            }
+
             /**
              * @brief easy but inefficient version of create_timeline()
              *
@@ -252,11 +278,24 @@ namespace openjij {
             template<typename RandomNumberEngine>
             static std::vector<TimeType> generate_poisson_points(const TimeType lambda, const TimeType beta,
                                                                  RandomNumberEngine& random_number_engine) {
+                std::vector<TimeType> poisson_points;
+                generate_poisson_points(lambda, beta, random_number_engine, poisson_points);
+                return poisson_points;
+            }
+
+            /**
+             * @brief generates Poisson points with density lambda in the range of [0:beta) into the given buffer (its capacity is reused)
+             *
+             */
+            template<typename RandomNumberEngine>
+            static void generate_poisson_points(const TimeType lambda, const TimeType beta,
+                                                RandomNumberEngine& random_number_engine,
+                                                std::vector<TimeType>& poisson_points) {
                 std::uniform_real_distribution<> rand(0.0, 1.0);
                 std::uniform_real_distribution<> rand_beta(0.0, beta);
 
                 const TimeType coef = beta*lambda;
-                TimeType n = 0;
+                std::size_t n = 0;
                 TimeType d = std::exp(-coef);
                 TimeType p = d;
                 TimeType xi = rand(random_number_engine);
@@ -267,13 +306,73 @@ namespace openjij {
                     p += d;
                 }
 
-                std::vector<TimeType> poisson_points(n);
-                for(int k = 0;k < n;k++) {
+                poisson_points.resize(n);
+                for(std::size_t k = 0;k < n;k++) {
                     poisson_points[k] = rand_beta(random_number_engine);
                 }
                 std::sort(poisson_points.begin(), poisson_points.end());
+            }
 
-                return poisson_points;
+        private:
+
+            /**
+             * @brief merge the kinks of an old timeline and new cuts into a new timeline
+             *
+             * @param size number of time points of the old timeline
+             * @param cut_point_at cut_point_at(k) gives kth time point of the old timeline and the spin after it
+             * @param cuts sorted new cuts
+             * @param append append(cut_point) adds a time point to the new timeline
+             */
+            template<typename CutPointAt, typename Append>
+            static void merge_cuts(std::size_t size, CutPointAt&& cut_point_at, const std::vector<TimeType>& cuts, Append&& append) {
+                /* kinks are the points whose spin differs from the one just before (periodic boundary condition),
+                 * the other old points are redundant cuts and are dropped on the fly
+                 */
+                auto current_spin = cut_point_at(size-1).second;
+                auto cuts_itr = cuts.begin();
+                bool empty = true;
+                for(std::size_t k = 0;k < size;k++) {
+                    const CutPoint cut_point = cut_point_at(k);
+                    if(cut_point.second == current_spin) {
+                        continue;
+                    }
+
+                    /* place cuts earlier than the kink */
+                    for(;cuts_itr != cuts.end() && *cuts_itr < cut_point.first;cuts_itr++) {
+                        append(CutPoint(*cuts_itr, current_spin));
+                    }
+                    append(cut_point);
+                    current_spin = cut_point.second;
+                    empty = false;
+                }
+
+                /* if entire timeline is occupied by single spin state and there are no cuts */
+                if(empty && cuts.empty()) {
+                    append(cut_point_at(0));
+                    return;
+                }
+
+                /* add remaining cuts */
+                for(;cuts_itr != cuts.end();cuts_itr++) {
+                    append(CutPoint(*cuts_itr, current_spin));
+                }
+            }
+
+            /**
+             * @brief galloping search of advance_cursor over the time points time_of(begin[k])
+             */
+            template<typename Iterator, typename TimeOf>
+            static std::size_t gallop(Iterator begin, std::size_t size, std::size_t cursor, TimeType time_point, TimeOf time_of) {
+                std::size_t bound = 1;
+                while(cursor + bound <= size && !(time_point < time_of(begin[cursor+bound-1]))) {
+                    bound *= 2;
+                }
+
+                auto first = begin + (cursor + bound/2);
+                auto last = begin + std::min(cursor + bound, size);
+                return std::distance(begin,
+                                     std::upper_bound(first, last, time_point,
+                                                      [&](TimeType t, const auto& x) { return t < time_of(x); }));
             }
         };
     } // namespace updater
@@ -0,0 +1,144 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UPDATER_HOUDAYER_HPP__
+#define OPENJIJ_UPDATER_HOUDAYER_HPP__
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+#include <graph/all.hpp>
+#include <system/classical_ising.hpp>
+#include <updater/single_spin_flip.hpp>
+#include <utility/schedule_list.hpp>
+
+namespace openjij {
+    namespace updater {
+
+        /**
+         * @brief Houdayer isoenergetic cluster move updater (operates on a pair of replicas)
+         *
+         * @tparam System
+         */
+        template<typename System>
+        struct Houdayer;
+
+        /**
+         * @brief Houdayer cluster move for classical ising model (on Sparse graph)
+         * J. Houdayer, Eur. Phys. J. B 22, 479 (2001).
+         *
+         * Two replicas at the same temperature are compared site by site.
+         * A connected cluster of the sites where the replicas disagree is swapped between the replicas,
+         * which keeps the sum of the two energies unchanged, so that the move is always accepted.
+         *
+         * @tparam FloatType
+         */
+        template<typename FloatType>
+        struct Houdayer<system::ClassicalIsing<graph::Sparse<FloatType>>> {
+
+            using ClIsing = system::ClassicalIsing<graph::Sparse<FloatType>>;
+
+            /**
+             * @brief one Houdayer step: a single spin flip sweep of each replica followed by a cluster move
+             *
+             * @param replica_a first replica
+             * @param replica_b second replica (must share the interaction with replica_a)
+             * @param random_number_engine random number engine
+             * @param parameter parameter object including inverse temperature \f\beta:=(k_B T)^{-1}\f
+             */
+            template<typename RandomNumberEngine>
+            inline static void update(ClIsing& replica_a,
+                                      ClIsing& replica_b,
+                                      RandomNumberEngine& random_number_engine,
+                                      const utility::ClassicalUpdaterParameter& parameter) {
+                SingleSpinFlip<ClIsing>::update(replica_a, random_number_engine, parameter);
+                SingleSpinFlip<ClIsing>::update(replica_b, random_number_engine, parameter);
+                cluster_move(replica_a, replica_b, random_number_engine);
+            }
+
+            /**
+             * @brief swap a randomly chosen cluster of disagreeing sites between two replicas
+             *
+             * @param replica_a first replica
+             * @param replica_b second replica (must share the interaction with replica_a)
+             * @param random_number_engine random number engine
+             *
+             * @return number of sites swapped
+             */
+            template<typename RandomNumberEngine>
+            static std::size_t cluster_move(ClIsing& replica_a,
+                                            ClIsing& replica_b,
+                                            RandomNumberEngine& random_number_engine) {
+                assert(replica_a.num_spins == replica_b.num_spins);
+                const std::size_t num_spins = replica_a.num_spins;
+
+                // fix the gauge so that the dummy spin is +1 in both replicas
+                // (some updaters, e.g. SwendsenWang, may flip it)
+                replica_a.fix_gauge();
+                replica_b.fix_gauge();
+
+                // 1. collect the sites where the two replicas disagree
+                std::vector<std::size_t> disagreement;
+                for(std::size_t i = 0; i < num_spins; ++i) {
+                    if(replica_a.spin(i) != replica_b.spin(i)) {
+                        disagreement.push_back(i);
+                    }
+                }
+
+                // swapping all the sites just exchanges the replicas
+                if(disagreement.empty() || disagreement.size() == num_spins) {
+                    return 0;
+                }
+
+                // 2. grow a cluster of disagreeing sites from a random seed site
+                auto uid = std::uniform_int_distribution<std::size_t>(0, disagreement.size()-1);
+                const std::size_t seed_site = disagreement[uid(random_number_engine)];
+
+                std::vector<bool> in_cluster(num_spins, false);
+                std::vector<std::size_t> stack{seed_site};
+                in_cluster[seed_site] = true;
+                std::size_t cluster_size = 0;
+
+                while(!stack.empty()) {
+                    const std::size_t node = stack.back();
+                    stack.pop_back();
+
+                    // 3. swap the spin between the replicas (the replicas disagree, so this is a flip of both)
+                    replica_a.spin(node) *= -1;
+                    replica_b.spin(node) *= -1;
+                    ++cluster_size;
+
+                    for(typename ClIsing::SparseMatrixXx::InnerIterator it(replica_a.interaction, node); it; ++it) {
+                        const std::size_t adj_node = it.index();
+                        // skip the dummy spin and vanishing couplings
+                        if(adj_node >= num_spins || it.value() == 0) continue;
+                        if(in_cluster[adj_node]) continue;
+                        if(replica_a.spin(adj_node) == replica_b.spin(adj_node)) continue;
+                        in_cluster[adj_node] = true;
+                        stack.push_back(adj_node);
+                    }
+                }
+
+                // 4. the energies of both replicas are changed
+                replica_a.refresh_observables();
+                replica_b.refresh_observables();
+
+                return cluster_size;
+            }
+        };
+    } // namespace updater
+} // namespace openjij
+
+#endif
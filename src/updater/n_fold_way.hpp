@@ -0,0 +1,335 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UPDATER_N_FOLD_WAY_HPP__
+#define OPENJIJ_UPDATER_N_FOLD_WAY_HPP__
+
+#include <any>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <system/classical_ising.hpp>
+#include <utility/grouped_indices.hpp>
+#include <utility/schedule_list.hpp>
+#include <utility/sum_tree.hpp>
+
+namespace openjij {
+    namespace updater {
+
+        /**
+         * @brief rejection-free n-fold way (Bortz-Kalos-Lebowitz) updater
+         *
+         * @tparam System type of system
+         */
+        template<typename System>
+        struct NFoldWay;
+
+        /**
+         * @brief n-fold way for classical ising model with sparse interactions
+         *
+         * @details this is the continuous-time version of single spin flip with the Metropolis rates min(1, exp(-beta dE)).
+         * the next flipped spin is sampled directly from the rates and the clock is advanced by an exponential waiting time.
+         * one update corresponds to one sweep (num_spins trials) of single spin flip.
+         * after each flip, the local fields and the rates of the neighbors are updated,
+         * thus an update is much faster than a sweep of single spin flip at low temperature, where almost all the trials are rejected.
+         *
+         * the rates are kept in one of the two ways (in NFoldWay::Workspace, which is stored in system.workspace.updater_workspace):
+         * - if the energy differences take at most max_num_classes distinct values (e.g. integer couplings), the spins are grouped by the energy difference (Bortz-Kalos-Lebowitz classes).
+         *   a class is sampled in proportion to (number of spins) * (rate) in O(number of classes), then a spin in it uniformly.
+         *   a change of beta costs O(number of classes), so that annealing with one sweep per beta stays cheap.
+         * - otherwise the rate of each spin is kept in a sum tree (O(degree log num_spins) per flip).
+         *   the tree is rebuilt in O(num_spins) when beta is changed, so use several sweeps per beta (e.g. a schedule list) for such models.
+         *
+         * the local fields are kept in system.workspace (see ClassicalIsing::synchronize_local_field).
+         * the local fields and the rates are recomputed if the spins are changed by others (e.g. reset_spins or another updater), which is detected by ClassicalIsing::spin_revision.
+         * since there are no trials, the observables count num_spins - (number of flips) rejections for each update.
+         *
+         * @tparam FloatType type of floating-point
+         */
+        template<typename FloatType>
+        struct NFoldWay<system::ClassicalIsing<graph::Sparse<FloatType>>> {
+
+            /**
+             * @brief ClassicalIsing with sparse interactions
+             */
+            using ClIsing = system::ClassicalIsing<graph::Sparse<FloatType>>;
+
+            /**
+             * @brief the rates are kept in the sum tree if the energy differences take more distinct values than this
+             */
+            static constexpr std::size_t max_num_classes = 64;
+
+            /**
+             * @brief rates of the spins kept across updates
+             */
+            struct Workspace {
+                /**
+                 * @brief flip rates of the spins (used if the energy differences take many distinct values)
+                 */
+                utility::SumTree flip_rate;
+
+                /**
+                 * @brief buffer to build flip_rate
+                 */
+                std::vector<double> rate_buffer;
+
+                /**
+                 * @brief spins grouped by the energy difference of the flip (Bortz-Kalos-Lebowitz classes)
+                 */
+                utility::GroupedIndices<FloatType> delta_energy_class;
+
+                /**
+                 * @brief flip rate of a spin in each class of delta_energy_class
+                 */
+                std::vector<double> class_rate;
+
+                /**
+                 * @brief whether the rates are kept in delta_energy_class and class_rate (true) or in flip_rate (false)
+                 */
+                bool use_class_rate = false;
+
+                /**
+                 * @brief inverse temperature of the rates
+                 */
+                double beta = -1;
+
+                /**
+                 * @brief ClassicalIsing::spin_revision for which the rates are computed
+                 */
+                std::size_t spin_revision = std::numeric_limits<std::size_t>::max();
+            };
+
+            /**
+             * @brief workspace of n-fold way kept in the system (nullptr if the system has not been updated by n-fold way)
+             *
+             * @param system
+             */
+            inline static const Workspace* find_workspace(const ClIsing& system) {
+                return std::any_cast<Workspace>(&system.workspace.updater_workspace);
+            }
+
+            /**
+             * @brief advance a classical ising system by one sweep of continuous time
+             *
+             * @param system object of a classical ising system
+             * @param random_number_engine random number engine
+             * @param parameter parameter object including inverse temperature \f\beta:=(k_B T)^{-1}\f
+             */
+            template<typename RandomNumberEngine>
+            inline static void update(ClIsing& system,
+                                      RandomNumberEngine& random_number_engine,
+                                      const utility::ClassicalUpdaterParameter& parameter) {
+                auto urd = std::uniform_real_distribution<>(0, 1.0);
+                auto& workspace = get_workspace(system);
+
+                // fix the gauge so that the dummy spin is +1
+                system.fix_gauge();
+
+                // the rates are rebuilt if the spins are changed by others or the local fields are recomputed.
+                // if only beta is changed, the class rates are recomputed (the sum tree is rebuilt)
+                const bool recomputed = system.synchronize_local_field();
+                if (recomputed || workspace.spin_revision != system.spin_revision) {
+                    build_rates(system, workspace, parameter.beta);
+                }
+                else if (workspace.beta != parameter.beta) {
+                    if (workspace.use_class_rate) {
+                        set_class_rates(workspace, parameter.beta);
+                    }
+                    else {
+                        build_flip_rate(system, workspace, parameter.beta);
+                    }
+                }
+
+                // clock in units of sweeps
+                double time = 0;
+                std::size_t num_flips = 0;
+                while (true) {
+                    const double total_rate = workspace.use_class_rate ? total_class_rate(workspace) : workspace.flip_rate.total();
+                    if (!(total_rate > 0)) {
+                        break;
+                    }
+                    time += -std::log(1.0 - urd(random_number_engine)) / total_rate;
+                    if (time >= 1.0) {
+                        break;
+                    }
+                    const double u = urd(random_number_engine) * total_rate;
+                    const auto index = workspace.use_class_rate ? find_in_classes(workspace, u) : workspace.flip_rate.find(u);
+                    flip(system, workspace, index, parameter.beta);
+                    ++num_flips;
+                }
+                workspace.spin_revision = system.spin_revision;
+
+                // single spin flip would have made num_spins trials
+                if (num_flips < system.num_spins) {
+                    system.observables.reject(system.num_spins - num_flips);
+                }
+            }
+
+        private:
+
+            /**
+             * @brief workspace of n-fold way in the system (created if the slot is empty or used by another updater)
+             */
+            inline static Workspace& get_workspace(ClIsing& system) {
+                auto& slot = system.workspace.updater_workspace;
+                if (auto* workspace = std::any_cast<Workspace>(&slot)) {
+                    return *workspace;
+                }
+                return slot.template emplace<Workspace>();
+            }
+
+            /**
+             * @brief Metropolis rate of a flip with energy difference dE
+             */
+            inline static double rate(FloatType dE, double beta) {
+                return (dE <= 0) ? 1.0 : std::exp(-beta * dE);
+            }
+
+            /**
+             * @brief group the spins by the energy difference, or build the sum tree if there are too many classes
+             */
+            inline static void build_rates(const ClIsing& system, Workspace& workspace, double beta) {
+                auto& classes = workspace.delta_energy_class;
+                classes.reset(system.num_spins);
+                workspace.use_class_rate = true;
+                for (std::size_t i = 0; i < system.num_spins; ++i) {
+                    classes.assign(i, system.delta_energy(i));
+                    if (classes.num_groups() > max_num_classes) {
+                        workspace.use_class_rate = false;
+                        break;
+                    }
+                }
+
+                if (workspace.use_class_rate) {
+                    set_class_rates(workspace, beta);
+                }
+                else {
+                    build_flip_rate(system, workspace, beta);
+                }
+            }
+
+            /**
+             * @brief compute the rate of each class in O(number of classes)
+             */
+            inline static void set_class_rates(Workspace& workspace, double beta) {
+                const auto& classes = workspace.delta_energy_class;
+                workspace.class_rate.resize(classes.num_groups());
+                for (std::size_t k = 0; k < classes.num_groups(); ++k) {
+                    workspace.class_rate[k] = rate(classes.key(k), beta);
+                }
+                workspace.beta = beta;
+            }
+
+            /**
+             * @brief build the sum tree of the rates of the spins in O(num_spins)
+             */
+            inline static void build_flip_rate(const ClIsing& system, Workspace& workspace, double beta) {
+                auto& rates = workspace.rate_buffer;
+                rates.resize(system.num_spins);
+                for (std::size_t i = 0; i < system.num_spins; ++i) {
+                    rates[i] = rate(system.delta_energy(i), beta);
+                }
+                workspace.flip_rate.reset(system.num_spins);
+                workspace.flip_rate.assign(rates);
+                workspace.use_class_rate = false;
+                workspace.beta = beta;
+            }
+
+            /**
+             * @brief sum of the rates of all the spins (classes)
+             */
+            inline static double total_class_rate(const Workspace& workspace) {
+                const auto& classes = workspace.delta_energy_class;
+                double total = 0;
+                for (std::size_t k = 0; k < classes.num_groups(); ++k) {
+                    total += classes.group_size(k) * workspace.class_rate[k];
+                }
+                return total;
+            }
+
+            /**
+             * @brief spin whose cumulative rate contains u (classes)
+             *
+             * @param u value in [0, total_class_rate(workspace))
+             */
+            inline static std::size_t find_in_classes(const Workspace& workspace, double u) {
+                const auto& classes = workspace.delta_energy_class;
+                std::size_t last = 0;
+                for (std::size_t k = 0; k < classes.num_groups(); ++k) {
+                    const std::size_t size = classes.group_size(k);
+                    const double class_rate = workspace.class_rate[k];
+                    if (size == 0 || !(class_rate > 0)) {
+                        continue;
+                    }
+                    const double weight = size * class_rate;
+                    if (u < weight) {
+                        // a spin in the class is chosen uniformly
+                        return classes.member(k, std::min(size - 1, static_cast<std::size_t>(u / class_rate)));
+                    }
+                    u -= weight;
+                    last = k;
+                }
+                // u is out of range due to rounding errors
+                return classes.member(last, classes.group_size(last) - 1);
+            }
+
+            /**
+             * @brief move ith spin to the class of its energy difference (switch to the sum tree if there are too many classes)
+             */
+            inline static void update_class(const ClIsing& system, Workspace& workspace, std::size_t index, double beta) {
+                auto& classes = workspace.delta_energy_class;
+                const FloatType dE = system.delta_energy(index);
+                const std::size_t k = classes.assign(index, dE);
+                if (k == workspace.class_rate.size()) {
+                    workspace.class_rate.push_back(rate(dE, beta));
+                }
+                if (classes.num_groups() > max_num_classes) {
+                    build_flip_rate(system, workspace, beta);
+                }
+            }
+
+            /**
+             * @brief flip ith spin and update the rates of the spin and its neighbors
+             */
+            inline static void flip(ClIsing& system, Workspace& workspace, std::size_t index, double beta) {
+                system.flip_with_local_field(index);
+
+                for (typename ClIsing::SparseMatrixXx::InnerIterator it(system.interaction, index); it; ++it) {
+                    const std::size_t j = it.index();
+                    if (j < system.num_spins && j != index) {
+                        if (workspace.use_class_rate) {
+                            update_class(system, workspace, j, beta);
+                        }
+                        else {
+                            workspace.flip_rate.set(j, rate(system.delta_energy(j), beta));
+                        }
+                    }
+                }
+                if (workspace.use_class_rate) {
+                    update_class(system, workspace, index, beta);
+                }
+                else {
+                    workspace.flip_rate.set(index, rate(system.delta_energy(index), beta));
+                }
+            }
+        };
+
+    } // namespace updater
+} // namespace openjij
+
+#endif
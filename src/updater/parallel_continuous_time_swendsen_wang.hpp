@@ -0,0 +1,169 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UPDATER_PARALLEL_CONTINUOUS_TIME_SWENDSEN_WANG_HPP__
+#define OPENJIJ_UPDATER_PARALLEL_CONTINUOUS_TIME_SWENDSEN_WANG_HPP__
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cassert>
+
+#include <graph/all.hpp>
+#include <system/continuous_time_ising.hpp>
+#include <updater/continuous_time_swendsen_wang.hpp>
+#include <utility/schedule_list.hpp>
+#include <utility/union_find.hpp>
+#include <utility/parallel.hpp>
+#include <utility/random.hpp>
+
+namespace openjij {
+    namespace updater {
+
+        /**
+         * @brief multi-threaded Continuous Time Swendsen Wang updater
+         *
+         * @tparam System
+         */
+        template<typename System>
+        struct ParallelContinuousTimeSwendsenWang;
+
+        /**
+         * @brief multi-threaded Continuous Time Swendsen Wang updater for CTQIsystem
+         *
+         * @details the three steps of ContinuousTimeSwendsenWang (cut placement for each site, bond placement for each edge and cluster flip)
+         * run in OpenMP parallel loops. every site (step 1) and every row of the interaction (step 2) has its own SplitMix64 engine
+         * seeded from the given engine, and a cluster is flipped by a hash of its smallest node (step 3).
+         * thus the result depends only on the given engine and not on the number of threads.
+         * without OpenMP, this is a serial updater which samples the same distribution as ContinuousTimeSwendsenWang.
+         *
+         * @tparam FloatType
+         */
+        template<typename FloatType>
+        struct ParallelContinuousTimeSwendsenWang<system::ContinuousTimeIsing<graph::Sparse<FloatType>>> {
+            using CTIsing = system::ContinuousTimeIsing<graph::Sparse<FloatType>>;
+            using GraphType = typename graph::Sparse<FloatType>;
+            using CutPoint = typename system::ContinuousTimeIsing<GraphType>::CutPoint;
+            using TimeType = typename system::ContinuousTimeIsing<GraphType>::TimeType;
+            using SerialUpdater = ContinuousTimeSwendsenWang<CTIsing>;
+
+            /**
+             * @brief multi-threaded continuous time Swendsen-Wang updater for transverse ising model
+             *
+             */
+            template <typename RandomNumberEngine>
+            static void update(system::ContinuousTimeIsing<GraphType>& system,
+                               RandomNumberEngine& random_number_engine,
+                               const utility::TransverseFieldUpdaterParameter& parameter) {
+
+                const std::size_t num_spin = system.num_spins;
+                auto& workspace = system.workspace;
+
+                const std::size_t num_threads = utility::get_max_threads();
+                workspace.thread_poisson_points.resize(num_threads);
+
+                /* 1. remove old cuts and place new cuts for every site.
+                 * the sites are divided into contiguous blocks, each block is rebuilt by a thread into its own configuration,
+                 * and then the blocks are concatenated in order into the spare configuration, which is swapped with spin_config.
+                 */
+                auto& seeds = workspace.seeds;
+                utility::generate_seeds(random_number_engine, num_spin, seeds);
+
+                const std::size_t num_blocks = std::min(num_spin, block_factor*num_threads);
+                auto& blocks = workspace.block_spin_configs;
+                blocks.resize(num_blocks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for(std::size_t b = 0;b < num_blocks;b++) {
+                    auto& cuts = workspace.thread_poisson_points[utility::get_thread_num()];
+                    auto& block = blocks[b];
+                    block.clear();
+                    for(std::size_t i = num_spin*b/num_blocks;i < num_spin*(b+1)/num_blocks;i++) {
+                        utility::SplitMix64 site_engine(seeds[i]);
+                        SerialUpdater::generate_poisson_points(0.5*system.gamma*(1.0-parameter.s), parameter.beta, site_engine, cuts);
+                        // assuming transverse field gamma is positive
+
+                        SerialUpdater::create_timeline(system.spin_config, i, cuts, block);
+                    }
+                }
+
+                auto& new_spin_config = workspace.spin_config;
+                new_spin_config.clear();
+                for(const auto& block : blocks) {
+                    new_spin_config.append(block);
+                }
+                system.spin_config.swap(new_spin_config);
+                auto& spin_config = system.spin_config;
+
+                /* 2. place spacial bonds */
+                auto& union_find_tree = workspace.concurrent_union_find_tree;
+                union_find_tree.reset(spin_config.num_time_points());
+                utility::generate_seeds(random_number_engine, num_spin, seeds);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+                for(std::size_t i = 0;i < num_spin;i++) {
+                    auto& bonds = workspace.thread_poisson_points[utility::get_thread_num()];
+                    utility::SplitMix64 row_engine(seeds[i]);
+
+                    for(typename CTIsing::SparseMatrixXx::InnerIterator it(system.interaction, i); it; ++it) {
+                        std::size_t j = it.index();
+                        const FloatType& J = it.value();
+                        if (i < j) {
+                            continue; // ignore duplicated interaction
+                        }
+
+                        SerialUpdater::generate_poisson_points(std::abs(0.5*J*parameter.s),
+                                                               parameter.beta, row_engine, bonds);
+                        SerialUpdater::place_bonds(spin_config, i, j, J, bonds, union_find_tree);
+                    }
+                }
+
+                /* 3. flip clusters
+                 * the root of each cluster is its smallest node, so a cluster is flipped (with the probability 1/2)
+                 * according to a bit of the hash of its root and a salt drawn from the given engine.
+                 * each thread flips the time points of whole words of the packed spins.
+                 */
+                utility::generate_seeds(random_number_engine, 1, seeds);
+                const std::uint64_t salt = seeds[0];
+                const std::size_t num_nodes = spin_config.num_time_points();
+                const std::size_t num_words = spin_config.num_words();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+                for(std::size_t w = 0;w < num_words;w++) {
+                    const std::size_t last = std::min(num_nodes, (w+1)*CTIsing::CompactConfiguration::word_bits);
+                    for(std::size_t node = w*CTIsing::CompactConfiguration::word_bits;node < last;node++) {
+                        const std::uint64_t root_index = union_find_tree.find_set(node);
+                        if(utility::SplitMix64::mix(salt ^ root_index) >> 63) {
+                            spin_config.flip_at(node);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief number of blocks of sites per thread in the cut placement (for load balancing)
+             */
+            static constexpr std::size_t block_factor = 8;
+        };
+    } // namespace updater
+} // namespace openjij
+
+#endif
@@ -0,0 +1,160 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UPDATER_PARALLEL_SINGLE_SPIN_FLIP_HPP__
+#define OPENJIJ_UPDATER_PARALLEL_SINGLE_SPIN_FLIP_HPP__
+
+#include <random>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <system/transverse_ising.hpp>
+#include <updater/single_spin_flip.hpp>
+#include <utility/schedule_list.hpp>
+#include <utility/parallel.hpp>
+#include <utility/random.hpp>
+
+namespace openjij {
+    namespace updater {
+
+        /**
+         * @brief multi-threaded single spin flip updater
+         *
+         * @tparam System type of system
+         */
+        template<typename System>
+        struct ParallelSingleSpinFlip;
+
+        /**
+         * @brief multi-threaded single spin flip for transverse field ising model (with Eigen implementation)
+         *
+         * @details a trotter slice couples only to the neighboring slices, so all the even slices are updated at the same time,
+         * and then all the odd slices. if the number of slices is odd, the last slice (a neighbor of the slice 0) is updated alone.
+         * each slice is swept by num_classical_spins trials with its own SplitMix64 engine seeded from the given engine,
+         * thus the result does not depend on the number of threads.
+         * the worldline moves (see system.worldline_flip_ratio) are tried after the slices are swept, in the same way as SingleSpinFlip.
+         *
+         * @tparam GraphType graph type (assume Dense<FloatType> or Sparse<FloatType>)
+         */
+        template<typename GraphType>
+        struct ParallelSingleSpinFlip<system::TransverseIsing<GraphType>> {
+
+            /**
+             * @brief transverse field ising system
+             */
+            using QIsing = system::TransverseIsing<GraphType>;
+
+            /**
+             * @brief float type
+             */
+            using FloatType = typename GraphType::value_type;
+
+            /**
+             * @brief operate single spin flip in a transverse ising system with even/odd slice decomposition
+             *
+             * @param system object of a transverse ising system
+             * @param random_number_engine random number engine
+             * @param parameter parameter object including inverse temperature \f\beta:=(k_B T)^{-1}\f and transverse magnetic field \f\s\f
+             */
+            template<typename RandomNumberEngine>
+                inline static void update(QIsing& system,
+                        RandomNumberEngine& random_numder_engine,
+                        const utility::TransverseFieldUpdaterParameter& parameter) {
+
+                    //get number of trotter slices
+                    const std::size_t num_trotter_slices = system.trotter_spins.cols();
+
+                    //coefficients of classical and trotter-direction terms (constant during this call)
+                    const FloatType classical_coef = -2 * parameter.s * (parameter.beta/num_trotter_slices);
+                    const FloatType trotter_coef = -2 * (1/2.) * log(tanh(parameter.beta * system.gamma * (1.0-parameter.s) /num_trotter_slices));
+
+                    //recalculate local fields if the rounding errors may have accumulated
+                    system.synchronize_local_field();
+
+                    //one seed for each slice
+                    std::vector<std::uint64_t> seeds;
+                    utility::generate_seeds(random_numder_engine, num_trotter_slices, seeds);
+
+                    //the last slice of odd number of slices is updated alone
+                    const std::size_t num_paired_slices = num_trotter_slices - num_trotter_slices%2;
+
+                    std::size_t num_flips = 0;
+                    for(std::size_t parity=0; parity<2; parity++){
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+: num_flips)
+#endif
+                        for(std::size_t index_trot=parity; index_trot<num_paired_slices; index_trot+=2){
+                            num_flips += update_slice(system, index_trot, seeds[index_trot], classical_coef, trotter_coef);
+                        }
+                    }
+
+                    if(num_paired_slices != num_trotter_slices){
+                        num_flips += update_slice(system, num_trotter_slices-1, seeds[num_trotter_slices-1], classical_coef, trotter_coef);
+                    }
+                    system.num_incremental_flips += num_flips;
+
+                    //worldline moves couple all the slices, thus they are done serially
+                    SingleSpinFlip<QIsing>::update_worldlines(system, random_numder_engine, parameter);
+                }
+
+            private:
+            /**
+             * @brief sweep a trotter slice by metropolis single spin flips (only this slice, its local fields and its energy are modified)
+             *
+             * @return number of accepted flips
+             */
+            inline static std::size_t update_slice(QIsing& system, std::size_t index_trot, std::uint64_t seed,
+                    FloatType classical_coef, FloatType trotter_coef){
+
+                const std::size_t num_classical_spins = system.num_classical_spins;
+                const std::size_t num_trotter_slices = system.trotter_spins.cols();
+
+                auto slice_engine = utility::SplitMix64(seed);
+                auto uid = std::uniform_int_distribution<std::size_t>{0, num_classical_spins-1};
+                auto urd = std::uniform_real_distribution<>(0, 1.0);
+
+                //aliases
+                auto& spins = system.trotter_spins;
+                auto& local_field = system.local_field;
+                const std::size_t next_trot = (index_trot+1)%num_trotter_slices;
+                const std::size_t prev_trot = (index_trot+num_trotter_slices-1)%num_trotter_slices;
+
+                std::size_t num_flips = 0;
+                for(std::size_t i=0; i<num_classical_spins; i++){
+                    //select random classical spin index
+                    std::size_t index = uid(slice_engine);
+                    assert(index < num_classical_spins);
+
+                    //local field in the trotter slice and trotter direction
+                    FloatType dE = classical_coef * spins(index, index_trot) * local_field(index, index_trot)
+                        + trotter_coef * spins(index, index_trot) * (spins(index, next_trot) + spins(index, prev_trot));
+
+                    //metropolis
+                    if(dE < 0 || exp(-dE) > urd(slice_engine)){
+                        system.slice_energy(index_trot) += -2 * spins(index, index_trot) * local_field(index, index_trot);
+                        local_field.col(index_trot) += (-2 * spins(index, index_trot)) * system.interaction.row(index).transpose();
+                        spins(index, index_trot) *= -1;
+                        ++num_flips;
+                    }
+                }
+                return num_flips;
+            }
+        };
+
+    } // namespace updater
+} // namespace openjij
+
+#endif
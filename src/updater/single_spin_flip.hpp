@@ -15,9 +15,13 @@
 #define OPENJIJ_UPDATER_SINGLE_SPIN_FLIP_HPP__
 
 #include <random>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include <system/classical_ising.hpp>
 #include <system/transverse_ising.hpp>
+#include <system/packed_transverse_ising.hpp>
 #include <utility/schedule_list.hpp>
 
 namespace openjij {
@@ -68,6 +72,9 @@ namespace openjij {
                 // to do Metroopolis
                 auto urd = std::uniform_real_distribution<>(0, 1.0);
 
+                // fix the gauge so that the dummy spin is +1
+                system.fix_gauge();
+
                 for (std::size_t time = 0; time < system.num_spins; ++time) {
 
                     // index of spin selected at random
@@ -79,7 +86,10 @@ namespace openjij {
 
                     // Flip the spin?
                     if (dE < 0 || std::exp( -parameter.beta * dE) > urd(random_numder_engine)) {
-                        system.spin(index) *= -1;
+                        system.flip(index, dE);
+                    }
+                    else {
+                        system.observables.reject();
                     }
 
                     //assure that the dummy spin is not changed.
@@ -91,6 +101,9 @@ namespace openjij {
         /**
          * @brief single spin flip for transverse field ising model (with Eigen implementation)
          *
+         * @details in addition to num_classical_spins*num_trotter_slices local flips,
+         * round(worldline_flip_ratio*num_classical_spins) worldline moves, which flip a classical spin in all the trotter slices, are tried in each update.
+         *
          * @tparam GraphType graph type (assume Dense<FloatType> or Sparse<FloatType>)
          */
         template<typename GraphType>
@@ -133,10 +146,18 @@ namespace openjij {
 
                     //aliases
                     auto& spins = system.trotter_spins;
+                    auto& local_field = system.local_field;
                     auto& gamma = system.gamma;
                     auto& beta = parameter.beta;
                     auto& s = parameter.s;
 
+                    //recalculate local fields if the rounding errors may have accumulated
+                    system.synchronize_local_field();
+
+                    //coefficients of classical and trotter-direction terms (constant during this call)
+                    const FloatType classical_coef = -2 * s * (beta/num_trotter_slices);
+                    const FloatType trotter_coef = -2 * (1/2.) * log(tanh(beta* gamma * (1.0-s) /num_trotter_slices));
+
                     for(std::size_t i=0; i<num_classical_spins*num_trotter_slices; i++){
                         //select random trotter slice
                         std::size_t index_trot = uid_trotter(random_numder_engine);
@@ -146,20 +167,75 @@ namespace openjij {
                         FloatType dE = 0;
                         assert(index < num_classical_spins);
                         assert(index_trot < num_trotter_slices);
-                        //calculate matrix dot product
-                        dE += -2 * s * (beta/num_trotter_slices) * spins(index, index_trot)*(system.interaction.row(index).dot(spins.col(index_trot)));
+                        //local field in the trotter slice
+                        dE += classical_coef * spins(index, index_trot) * local_field(index, index_trot);
 
                         //trotter direction
-                        dE += -2 * (1/2.) * log(tanh(beta* gamma * (1.0-s) /num_trotter_slices)) * spins(index, index_trot)*
+                        dE += trotter_coef * spins(index, index_trot)*
                             (  spins(index, mod_t((int64_t)index_trot+1, num_trotter_slices)) 
                              + spins(index, mod_t((int64_t)index_trot-1, num_trotter_slices)));
 
                         //metropolis 
                         if(dE < 0 || exp(-dE) > urd(random_numder_engine)){
+                            //update classical energy and local fields in the trotter slice (O(degree) for sparse interaction)
+                            system.slice_energy(index_trot) += -2 * spins(index, index_trot) * local_field(index, index_trot);
+                            local_field.col(index_trot) += (-2 * spins(index, index_trot)) * system.interaction.row(index).transpose();
                             spins(index, index_trot) *= -1;
+                            ++system.num_incremental_flips;
                         }
 
                     }
+
+                    //worldline moves (flip a classical spin in all the trotter slices at once)
+                    update_worldlines(system, random_numder_engine, parameter);
+                }
+
+            /**
+             * @brief try round(worldline_flip_ratio*num_classical_spins) worldline moves, each of which flips a classical spin in all the trotter slices.
+             * the trotter-direction terms do not change, so a move costs O(num_trotter_slices * degree).
+             * this is also used by ParallelSingleSpinFlip.
+             *
+             * @param system object of a transverse ising system
+             * @param random_number_engine random number engine
+             * @param parameter parameter object including inverse temperature \f\beta:=(k_B T)^{-1}\f and transverse magnetic field \f\s\f
+             */
+            template<typename RandomNumberEngine>
+                inline static void update_worldlines(QIsing& system,
+                        RandomNumberEngine& random_numder_engine,
+                        const utility::TransverseFieldUpdaterParameter& parameter) {
+
+                    const std::size_t num_classical_spins = system.num_classical_spins;
+                    const std::size_t num_trotter_slices = system.trotter_spins.cols();
+                    const std::size_t num_worldline_flips = static_cast<std::size_t>(std::round(system.worldline_flip_ratio * num_classical_spins));
+                    if(num_worldline_flips == 0){
+                        return;
+                    }
+
+                    auto uid = std::uniform_int_distribution<std::size_t>{0, num_classical_spins-1};
+                    auto urd = std::uniform_real_distribution<>(0, 1.0);
+
+                    //aliases
+                    auto& spins = system.trotter_spins;
+                    auto& local_field = system.local_field;
+                    const FloatType classical_coef = -2 * parameter.s * (parameter.beta/num_trotter_slices);
+
+                    for(std::size_t i=0; i<num_worldline_flips; i++){
+                        std::size_t index = uid(random_numder_engine);
+                        assert(index < num_classical_spins);
+
+                        //trotter-direction terms do not change
+                        const FloatType dE = classical_coef * spins.row(index).dot(local_field.row(index));
+
+                        //metropolis
+                        if(dE < 0 || exp(-dE) > urd(random_numder_engine)){
+                            for(std::size_t t=0; t<num_trotter_slices; t++){
+                                system.slice_energy(t) += -2 * spins(index, t) * local_field(index, t);
+                                local_field.col(t) += (-2 * spins(index, t)) * system.interaction.row(index).transpose();
+                            }
+                            spins.row(index) *= -1;
+                            system.num_incremental_flips += num_trotter_slices;
+                        }
+                    }
                 }
 
             private: 
@@ -170,6 +246,117 @@ namespace openjij {
             }
         };
 
+        /**
+         * @brief single spin flip for transverse field ising model with packed trotter spins
+         *
+         * @details sites are swept in order. for each site, local fields in all the trotter slices are calculated at once,
+         * and then the slices are updated in three groups (even slices, odd slices and the last slice if the number of slices is odd).
+         * no two slices in a group are neighbors, so the trotter-direction terms of a group are evaluated with bitwise operations on the packed words
+         * before any flip in the group is applied.
+         *
+         * @tparam FloatType
+         */
+        template<typename FloatType>
+        struct SingleSpinFlip<system::PackedTransverseIsing<graph::Sparse<FloatType>>> {
+
+            /**
+             * @brief transverse field ising system with packed trotter spins
+             */
+            using PQIsing = system::PackedTransverseIsing<graph::Sparse<FloatType>>;
+
+            /**
+             * @brief word of packed spins
+             */
+            using Word = typename PQIsing::Word;
+
+            /**
+             * @brief operate single spin flip in a transverse ising system with packed trotter spins
+             *
+             * @param system object of a transverse ising system
+             * @param random_number_engine random number engine
+             * @param parameter parameter object including inverse temperature \f\beta:=(k_B T)^{-1}\f and transverse magnetic field \f\s\f
+             */
+            template<typename RandomNumberEngine>
+                inline static void update(PQIsing& system,
+                        RandomNumberEngine& random_numder_engine,
+                        const utility::TransverseFieldUpdaterParameter& parameter) {
+
+                    const std::size_t num_classical_spins = system.num_classical_spins;
+                    const std::size_t num_trotter_slices = system.num_trotter_slices;
+                    const std::size_t num_words = system.num_words;
+                    constexpr std::size_t word_bits = PQIsing::word_bits;
+
+                    //coefficients of classical and trotter-direction terms (constant during this call)
+                    const FloatType classical_coef = -2 * parameter.s * (parameter.beta/num_trotter_slices);
+                    const FloatType trotter_coef = -2 * (1/2.) * log(tanh(parameter.beta * system.gamma * (1.0-parameter.s) /num_trotter_slices));
+
+                    auto urd = std::uniform_real_distribution<>(0, 1.0);
+
+                    std::vector<FloatType> local_field(num_trotter_slices);
+                    std::vector<Word> same_as_next(num_words);
+                    std::vector<Word> same_as_prev(num_words);
+                    std::vector<Word> flip_mask(num_words);
+
+                    for(std::size_t index=0; index<num_classical_spins; index++){
+                        //local fields in all the trotter slices
+                        std::fill(local_field.begin(), local_field.end(), FloatType(0));
+                        for(typename PQIsing::SparseMatrixXx::InnerIterator it(system.interaction, index); it; ++it){
+                            const std::size_t j = it.index();
+                            const FloatType J = it.value();
+                            if(j == index){
+                                continue;
+                            }
+                            if(j == num_classical_spins){
+                                //longitudinal field (dummy spin is always 1)
+                                for(auto& field : local_field){
+                                    field += J;
+                                }
+                                continue;
+                            }
+                            const Word* y = system.words(j);
+                            for(std::size_t t=0; t<num_trotter_slices; t++){
+                                local_field[t] += ((y[t/word_bits] >> (t%word_bits)) & 1) ? J : -J;
+                            }
+                        }
+
+                        Word* x = system.words(index);
+
+                        //groups of slices: [0, 2, ...], [1, 3, ...] and [T-1] if T is odd
+                        const std::size_t num_paired_slices = num_trotter_slices - num_trotter_slices%2;
+                        for(std::size_t group=0; group<3; group++){
+                            const std::size_t first = (group < 2) ? group : num_paired_slices;
+                            const std::size_t last = (group < 2) ? num_paired_slices : num_trotter_slices;
+
+                            //bit t is set if the spin in tth slice equals to that in the next (previous) slice
+                            for(std::size_t w=0; w<num_words; w++){
+                                same_as_next[w] = ~(x[w] ^ system.next_slice(x, w));
+                                same_as_prev[w] = ~(x[w] ^ system.prev_slice(x, w));
+                                flip_mask[w] = 0;
+                            }
+
+                            for(std::size_t t=first; t<last; t+=2){
+                                const std::size_t w = t/word_bits;
+                                const std::size_t b = t%word_bits;
+                                const FloatType spin = ((x[w] >> b) & 1) ? 1 : -1;
+                                // spin * (spin in next slice + spin in previous slice)
+                                const FloatType trotter_term = (((same_as_next[w] >> b) & 1) ? 1 : -1) + (((same_as_prev[w] >> b) & 1) ? 1 : -1);
+
+                                const FloatType dE = classical_coef * spin * local_field[t] + trotter_coef * trotter_term;
+
+                                //metropolis
+                                if(dE < 0 || exp(-dE) > urd(random_numder_engine)){
+                                    flip_mask[w] |= Word(1) << b;
+                                }
+                            }
+
+                            for(std::size_t w=0; w<num_words; w++){
+                                x[w] ^= flip_mask[w];
+                            }
+                        }
+                    }
+                }
+        };
+
     } // namespace updater
 } // namespace openjij
 
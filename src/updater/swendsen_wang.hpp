@@ -82,6 +82,12 @@ namespace openjij {
                 }();
 
                 // 3. update spin states in each cluster
+                // each cluster is counted as a trial (accepted if flipped) except the one including the dummy spin,
+                // whose flip is a gauge transformation combined with flips of the others.
+                // thus no flip is accepted if the system is frozen into a single cluster.
+                const auto dummy_root = union_find_tree.find_set(num_spin-1);
+                std::size_t num_flipped_clusters = 0;
+                std::size_t num_kept_clusters = 0;
                 for (auto&& c : union_find_tree.get_roots()) {
                     const auto range = cluster_map.equal_range(c);
 
@@ -93,9 +99,18 @@ namespace openjij {
                             const auto idx = itr->second;
                             system.spin(idx) *= -1;
                         }
+                        num_flipped_clusters += (c != dummy_root) ? 1 : 0;
+                    }
+                    else {
+                        num_kept_clusters += (c != dummy_root) ? 1 : 0;
                     }
                 }
 
+                // 4. recompute observables
+                system.refresh_observables();
+                system.observables.accept(num_flipped_clusters);
+                system.observables.reject(num_kept_clusters);
+
                 return;
             }
         };
@@ -0,0 +1,149 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UTILITY_BETA_RANGE_HPP__
+#define OPENJIJ_UTILITY_BETA_RANGE_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include <graph/dense.hpp>
+#include <graph/sparse.hpp>
+
+namespace openjij {
+    namespace utility {
+
+        /**
+         * @brief estimates of the energy change by a single spin flip
+         */
+        struct DeltaEnergyRange {
+
+            /**
+             * @brief the smallest nonzero coupling (or local field) in absolute value
+             */
+            double min_delta_energy = std::numeric_limits<double>::max();
+
+            /**
+             * @brief the largest sum of the absolute couplings (and the local field) of a spin
+             */
+            double max_delta_energy = 0;
+        };
+
+        /**
+         * @brief range of inverse temperature for simulated annealing
+         */
+        struct BetaRange {
+            double beta_min;
+            double beta_max;
+        };
+
+        /**
+         * @brief estimate the range of the energy change of dense graph.
+         * the rows are processed in parallel.
+         *
+         * @param graph
+         *
+         * @return estimated range
+         */
+        template<typename FloatType>
+        DeltaEnergyRange estimate_delta_energy_range(const graph::Dense<FloatType>& graph) {
+            // symmetric matrix with the local fields in the last column
+            const auto interaction = graph.get_interactions();
+            const std::size_t num_spins = graph.get_num_spins();
+            double min_delta_energy = std::numeric_limits<double>::max();
+            double max_delta_energy = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(min: min_delta_energy) reduction(max: max_delta_energy)
+#endif
+            for(std::size_t i = 0; i < num_spins; i++) {
+                double sum = 0;
+                for(std::size_t j = 0; j <= num_spins; j++) {
+                    const double abs_value = std::abs(static_cast<double>(interaction(i, j)));
+                    if(i == j || abs_value == 0) {
+                        continue;
+                    }
+                    sum += abs_value;
+                    min_delta_energy = std::min(min_delta_energy, abs_value);
+                }
+                max_delta_energy = std::max(max_delta_energy, sum);
+            }
+
+            return DeltaEnergyRange{min_delta_energy, max_delta_energy};
+        }
+
+        /**
+         * @brief estimate the range of the energy change of sparse graph.
+         * the spins are processed in parallel.
+         *
+         * @param graph
+         *
+         * @return estimated range
+         */
+        template<typename FloatType>
+        DeltaEnergyRange estimate_delta_energy_range(const graph::Sparse<FloatType>& graph) {
+            const std::size_t num_spins = graph.get_num_spins();
+            double min_delta_energy = std::numeric_limits<double>::max();
+            double max_delta_energy = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(min: min_delta_energy) reduction(max: max_delta_energy)
+#endif
+            for(std::size_t i = 0; i < num_spins; i++) {
+                double sum = 0;
+                for(auto&& j : graph.adj_nodes(i)) {
+                    // the diagonal element is the local field
+                    const double abs_value = std::abs(static_cast<double>((i == j) ? graph.h(i) : graph.J(i, j)));
+                    if(abs_value == 0) {
+                        continue;
+                    }
+                    sum += abs_value;
+                    min_delta_energy = std::min(min_delta_energy, abs_value);
+                }
+                max_delta_energy = std::max(max_delta_energy, sum);
+            }
+
+            return DeltaEnergyRange{min_delta_energy, max_delta_energy};
+        }
+
+        /**
+         * @brief estimate the range of inverse temperature for simulated annealing.
+         * beta_min makes the largest energy change accepted with probability initial_acceptance,
+         * and beta_max makes the smallest one accepted with probability final_acceptance.
+         *
+         * @param graph Dense or Sparse graph of ising model
+         * @param initial_acceptance acceptance probability at beta_min
+         * @param final_acceptance acceptance probability at beta_max
+         *
+         * @return estimated range
+         */
+        template<typename GraphType>
+        BetaRange estimate_beta_range(const GraphType& graph, double initial_acceptance = 0.5, double final_acceptance = 0.01) {
+            if(!(0 < final_acceptance && final_acceptance < 1 && 0 < initial_acceptance && initial_acceptance < 1)) {
+                throw std::invalid_argument("acceptance probabilities must be in (0, 1)");
+            }
+            const auto range = estimate_delta_energy_range(graph);
+            if(range.max_delta_energy == 0) {
+                throw std::runtime_error("all the interactions are zero");
+            }
+            return BetaRange{-std::log(initial_acceptance) / range.max_delta_energy, -std::log(final_acceptance) / range.min_delta_energy};
+        }
+
+    } // namespace utility
+} // namespace openjij
+
+#endif
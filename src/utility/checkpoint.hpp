@@ -0,0 +1,409 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UTILITY_CHECKPOINT_HPP__
+#define OPENJIJ_UTILITY_CHECKPOINT_HPP__
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <system/classical_ising.hpp>
+#include <system/transverse_ising.hpp>
+#include <system/continuous_time_ising.hpp>
+#include <utility/schedule_list.hpp>
+
+namespace openjij {
+    namespace utility {
+
+        /**
+         * @brief writer of the binary checkpoint format (native byte order)
+         */
+        class BinaryWriter {
+        public:
+            explicit BinaryWriter(std::ostream& os) : os(os) {}
+
+            /**
+             * @brief write a trivially copyable value
+             */
+            template<typename T>
+            void write(const T& value) {
+                static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+                os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            /**
+             * @brief write a length-prefixed string
+             */
+            void write_string(const std::string& str) {
+                write<std::uint64_t>(str.size());
+                os.write(str.data(), str.size());
+            }
+
+        private:
+            std::ostream& os;
+        };
+
+        /**
+         * @brief reader of the binary checkpoint format (native byte order)
+         */
+        class BinaryReader {
+        public:
+            explicit BinaryReader(std::istream& is) : is(is) {}
+
+            /**
+             * @brief read a trivially copyable value
+             */
+            template<typename T>
+            T read() {
+                static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+                T value;
+                if(!is.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+                    throw std::runtime_error("unexpected end of checkpoint");
+                }
+                return value;
+            }
+
+            /**
+             * @brief read a length-prefixed string
+             */
+            std::string read_string() {
+                std::string str(read<std::uint64_t>(), '\0');
+                if(!is.read(&str[0], str.size())) {
+                    throw std::runtime_error("unexpected end of checkpoint");
+                }
+                return str;
+            }
+
+            /**
+             * @brief read a size and check it against the expected one
+             */
+            void expect_size(std::uint64_t expected, const char* what) {
+                if(read<std::uint64_t>() != expected) {
+                    throw std::runtime_error(std::string("checkpoint does not match the system: ") + what);
+                }
+            }
+
+        private:
+            std::istream& is;
+        };
+
+        /* state of each system (the interaction is not saved) */
+
+        /**
+         * @brief kind of system saved in a checkpoint
+         */
+        enum class CheckpointSystemKind : std::uint32_t {
+            classical_ising = 1,
+            transverse_ising = 2,
+            continuous_time_ising = 3,
+        };
+
+        /**
+         * @brief kind of system and sizes of the floating point types, which must match between save and load
+         */
+        struct CheckpointLayout {
+            CheckpointSystemKind system_kind;
+
+            /**
+             * @brief sizeof(FloatType)
+             */
+            std::uint32_t float_size;
+
+            /**
+             * @brief sizeof(TimeType) (zero if the system has no continuous time)
+             */
+            std::uint32_t time_size;
+        };
+
+        template<typename GraphType>
+        constexpr CheckpointLayout checkpoint_layout(const system::ClassicalIsing<GraphType>&) {
+            return {CheckpointSystemKind::classical_ising, sizeof(typename GraphType::value_type), 0};
+        }
+
+        template<typename GraphType>
+        constexpr CheckpointLayout checkpoint_layout(const system::TransverseIsing<GraphType>&) {
+            return {CheckpointSystemKind::transverse_ising, sizeof(typename GraphType::value_type), 0};
+        }
+
+        template<typename GraphType>
+        constexpr CheckpointLayout checkpoint_layout(const system::ContinuousTimeIsing<GraphType>&) {
+            return {CheckpointSystemKind::continuous_time_ising, sizeof(typename GraphType::value_type),
+                    sizeof(typename system::ContinuousTimeIsing<GraphType>::TimeType)};
+        }
+
+        /**
+         * @brief write spins of classical ising system
+         */
+        template<typename GraphType>
+        void write_state(BinaryWriter& writer, const system::ClassicalIsing<GraphType>& system, bool /* exact_replay */) {
+            writer.write<std::uint64_t>(system.spin.size());
+            for(Eigen::Index i = 0; i < system.spin.size(); i++) {
+                writer.write<std::int8_t>(system.spin(i));
+            }
+        }
+
+        /**
+         * @brief read spins of classical ising system. the observables are recomputed (the acceptance counts and the best spins are reset).
+         */
+        template<typename GraphType>
+        void read_state(BinaryReader& reader, system::ClassicalIsing<GraphType>& system, bool /* exact_replay */) {
+            reader.expect_size(system.spin.size(), "number of spins");
+            for(Eigen::Index i = 0; i < system.spin.size(); i++) {
+                system.spin(i) = reader.read<std::int8_t>();
+            }
+            system.reset_observables();
+        }
+
+        /**
+         * @brief write trotter spins of transverse ising system.
+         * with exact_replay, the cached local fields, slice energies and the number of incremental flips since the last recalculation are also written as they are,
+         * since recomputing them may change the rounding errors and thus the following Metropolis decisions.
+         */
+        template<typename GraphType>
+        void write_state(BinaryWriter& writer, const system::TransverseIsing<GraphType>& system, bool exact_replay) {
+            using FloatType = typename GraphType::value_type;
+            const auto& spins = system.trotter_spins;
+            writer.write<std::uint64_t>(spins.rows());
+            writer.write<std::uint64_t>(spins.cols());
+            for(Eigen::Index t = 0; t < spins.cols(); t++) {
+                for(Eigen::Index i = 0; i < spins.rows(); i++) {
+                    writer.write<std::int8_t>(spins(i, t));
+                }
+            }
+            if(exact_replay) {
+                for(Eigen::Index t = 0; t < spins.cols(); t++) {
+                    for(Eigen::Index i = 0; i < spins.rows(); i++) {
+                        writer.write<FloatType>(system.local_field(i, t));
+                    }
+                    writer.write<FloatType>(system.slice_energy(t));
+                }
+                writer.write<std::uint64_t>(system.num_incremental_flips);
+            }
+        }
+
+        /**
+         * @brief read trotter spins of transverse ising system.
+         * the local fields and slice energies are read with exact_replay, and are recomputed otherwise.
+         */
+        template<typename GraphType>
+        void read_state(BinaryReader& reader, system::TransverseIsing<GraphType>& system, bool exact_replay) {
+            using FloatType = typename GraphType::value_type;
+            auto& spins = system.trotter_spins;
+            reader.expect_size(spins.rows(), "number of spins");
+            reader.expect_size(spins.cols(), "number of trotter slices");
+            for(Eigen::Index t = 0; t < spins.cols(); t++) {
+                for(Eigen::Index i = 0; i < spins.rows(); i++) {
+                    spins(i, t) = reader.read<std::int8_t>();
+                }
+            }
+            if(!exact_replay) {
+                system.reset_local_field();
+                return;
+            }
+            for(Eigen::Index t = 0; t < spins.cols(); t++) {
+                for(Eigen::Index i = 0; i < spins.rows(); i++) {
+                    system.local_field(i, t) = reader.read<FloatType>();
+                }
+                system.slice_energy(t) = reader.read<FloatType>();
+            }
+            system.num_incremental_flips = reader.read<std::uint64_t>();
+        }
+
+        /**
+         * @brief write spin configuration of continuous time ising system (including the auxiliary spin):
+         * the number of time points of each site, all the time points and the packed spins
+         */
+        template<typename GraphType>
+        void write_state(BinaryWriter& writer, const system::ContinuousTimeIsing<GraphType>& system, bool /* exact_replay */) {
+            using TimeType = typename system::ContinuousTimeIsing<GraphType>::TimeType;
+            const auto& spin_config = system.spin_config;
+            writer.write<std::uint64_t>(spin_config.num_sites());
+            for(std::size_t i = 0; i < spin_config.num_sites(); i++) {
+                writer.write<std::uint64_t>(spin_config.size(i));
+            }
+            for(std::size_t i = 0; i < spin_config.num_sites(); i++) {
+                for(std::size_t k = 0; k < spin_config.size(i); k++) {
+                    writer.write<TimeType>(spin_config.time(i, k));
+                }
+            }
+            for(const auto word : spin_config.words()) {
+                writer.write<std::uint64_t>(word);
+            }
+        }
+
+        /**
+         * @brief read spin configuration of continuous time ising system
+         */
+        template<typename GraphType>
+        void read_state(BinaryReader& reader, system::ContinuousTimeIsing<GraphType>& system, bool /* exact_replay */) {
+            using TimeType = typename system::ContinuousTimeIsing<GraphType>::TimeType;
+            using CompactConfiguration = typename system::ContinuousTimeIsing<GraphType>::CompactConfiguration;
+            reader.expect_size(system.spin_config.num_sites(), "number of spins");
+            std::vector<std::size_t> sizes(system.spin_config.num_sites());
+            std::size_t num_time_points = 0;
+            for(auto& size : sizes) {
+                size = reader.read<std::uint64_t>();
+                if(size == 0) {
+                    throw std::runtime_error("checkpoint has an empty timeline");
+                }
+                num_time_points += size;
+            }
+            std::vector<TimeType> times(num_time_points);
+            for(auto& time_point : times) {
+                time_point = reader.read<TimeType>();
+            }
+            std::vector<std::uint64_t> words((num_time_points + CompactConfiguration::word_bits - 1) / CompactConfiguration::word_bits);
+            for(auto& word : words) {
+                word = reader.read<std::uint64_t>();
+            }
+
+            auto& spin_config = system.spin_config;
+            spin_config.clear();
+            std::size_t index = 0;
+            for(const auto size : sizes) {
+                for(std::size_t k = 0; k < size; k++, index++) {
+                    const bool up = (words[index / CompactConfiguration::word_bits] >> (index % CompactConfiguration::word_bits)) & 1;
+                    spin_config.append(times[index], up ? 1 : -1);
+                }
+                spin_config.close_site();
+            }
+        }
+
+        /* checkpoint = header (magic, version, layout, flags) + position in the schedule list + random number engine + system */
+
+        /**
+         * @brief magic number at the beginning of a checkpoint ("OJCK")
+         */
+        constexpr std::uint32_t checkpoint_magic = 0x4b434a4f;
+
+        /**
+         * @brief version of the checkpoint format
+         */
+        constexpr std::uint32_t checkpoint_version = 4;
+
+        /**
+         * @brief flag of a checkpoint with the cached values for exact replay
+         */
+        constexpr std::uint32_t checkpoint_exact_replay = 1;
+
+        /**
+         * @brief save a run state
+         *
+         * @param os binary output stream
+         * @param system
+         * @param random_number_engine engine which supports operator<< (e.g. Xorshift, std::mt19937)
+         * @param position position in the schedule list
+         * @param exact_replay save the cached values of the system (e.g. the local fields of TransverseIsing) as well,
+         * so that the resumed run is bit-identical to the uninterrupted one. otherwise they are recomputed on load.
+         */
+        template<typename System, typename RandomNumberEngine>
+        void save_checkpoint(std::ostream& os, const System& system, const RandomNumberEngine& random_number_engine, const SchedulePosition& position, bool exact_replay = false) {
+            BinaryWriter writer(os);
+            writer.write<std::uint32_t>(checkpoint_magic);
+            writer.write<std::uint32_t>(checkpoint_version);
+            const CheckpointLayout layout = checkpoint_layout(system);
+            writer.write<std::uint32_t>(static_cast<std::uint32_t>(layout.system_kind));
+            writer.write<std::uint32_t>(layout.float_size);
+            writer.write<std::uint32_t>(layout.time_size);
+            writer.write<std::uint32_t>(exact_replay ? checkpoint_exact_replay : 0);
+            writer.write<std::uint64_t>(position.schedule_index);
+            writer.write<std::uint64_t>(position.step);
+
+            std::ostringstream engine_state;
+            engine_state << random_number_engine;
+            writer.write_string(engine_state.str());
+
+            write_state(writer, system, exact_replay);
+            if(!os) {
+                throw std::runtime_error("failed to write checkpoint");
+            }
+        }
+
+        /**
+         * @brief restore a run state saved by save_checkpoint
+         *
+         * @param is binary input stream
+         * @param system system with the same interaction as the saved one
+         * @param random_number_engine engine of the same type as the saved one
+         *
+         * @return position in the schedule list
+         */
+        template<typename System, typename RandomNumberEngine>
+        SchedulePosition load_checkpoint(std::istream& is, System& system, RandomNumberEngine& random_number_engine) {
+            BinaryReader reader(is);
+            if(reader.read<std::uint32_t>() != checkpoint_magic) {
+                throw std::runtime_error("not a checkpoint");
+            }
+            if(reader.read<std::uint32_t>() != checkpoint_version) {
+                throw std::runtime_error("unsupported checkpoint version");
+            }
+            const CheckpointLayout layout = checkpoint_layout(system);
+            if(reader.read<std::uint32_t>() != static_cast<std::uint32_t>(layout.system_kind)) {
+                throw std::runtime_error("checkpoint does not match the system: kind of system");
+            }
+            if(reader.read<std::uint32_t>() != layout.float_size) {
+                throw std::runtime_error("checkpoint does not match the system: floating point type");
+            }
+            if(reader.read<std::uint32_t>() != layout.time_size) {
+                throw std::runtime_error("checkpoint does not match the system: time type");
+            }
+            const bool exact_replay = reader.read<std::uint32_t>() & checkpoint_exact_replay;
+            SchedulePosition position;
+            position.schedule_index = reader.read<std::uint64_t>();
+            position.step = reader.read<std::uint64_t>();
+
+            std::istringstream engine_state(reader.read_string());
+            if(!(engine_state >> random_number_engine)) {
+                throw std::runtime_error("checkpoint has a broken random number engine state");
+            }
+
+            read_state(reader, system, exact_replay);
+            return position;
+        }
+
+        /**
+         * @brief save a run state to file
+         */
+        template<typename System, typename RandomNumberEngine>
+        void save_checkpoint(const std::string& filename, const System& system, const RandomNumberEngine& random_number_engine, const SchedulePosition& position, bool exact_replay = false) {
+            std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+            if(!ofs) {
+                throw std::runtime_error("cannot open " + filename);
+            }
+            save_checkpoint(static_cast<std::ostream&>(ofs), system, random_number_engine, position, exact_replay);
+        }
+
+        /**
+         * @brief restore a run state from file
+         */
+        template<typename System, typename RandomNumberEngine>
+        SchedulePosition load_checkpoint(const std::string& filename, System& system, RandomNumberEngine& random_number_engine) {
+            std::ifstream ifs(filename, std::ios::binary);
+            if(!ifs) {
+                throw std::runtime_error("cannot open " + filename);
+            }
+            return load_checkpoint(static_cast<std::istream&>(ifs), system, random_number_engine);
+        }
+
+    } // namespace utility
+} // namespace openjij
+
+#endif
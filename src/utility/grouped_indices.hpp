@@ -0,0 +1,151 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UTILITY_GROUPED_INDICES_HPP__
+#define OPENJIJ_UTILITY_GROUPED_INDICES_HPP__
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace openjij {
+    namespace utility {
+
+        /**
+         * @brief indices 0, ..., n-1 grouped by a key (e.g. the energy difference of a spin flip).
+         * an index is moved to another group in O(1) and the members of a group are listed without search.
+         *
+         * @details the groups are numbered in the order of creation and are not removed (they may be empty) until reset.
+         *
+         * @tparam KeyType type of key (hashable)
+         */
+        template<typename KeyType>
+        struct GroupedIndices {
+            using size_type = std::size_t;
+
+            /**
+             * @brief index which does not belong to any group
+             */
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+            explicit GroupedIndices(size_type n = 0) {
+                reset(n);
+            }
+
+            /**
+             * @brief remove all the groups and make n indices ungrouped, reusing the already allocated storage
+             *
+             * @param n number of indices
+             */
+            void reset(size_type n) {
+                _group_of.assign(n, npos);
+                _position.assign(n, 0);
+                _keys.clear();
+                _members.clear();
+                _group_index.clear();
+            }
+
+            /**
+             * @brief move ith index to the group of key (a group is created if there is none)
+             *
+             * @param i index
+             * @param key key of the group
+             *
+             * @return group of ith index
+             */
+            size_type assign(size_type i, const KeyType& key) {
+                assert(i < _group_of.size());
+                auto it = _group_index.find(key);
+                if (it == _group_index.end()) {
+                    it = _group_index.emplace(key, _keys.size()).first;
+                    _keys.push_back(key);
+                    _members.emplace_back();
+                }
+                const size_type group = it->second;
+                if (_group_of[i] != group) {
+                    remove(i);
+                    _group_of[i] = group;
+                    _position[i] = _members[group].size();
+                    _members[group].push_back(i);
+                }
+                return group;
+            }
+
+            /**
+             * @brief number of groups (including empty ones)
+             */
+            size_type num_groups() const {
+                return _keys.size();
+            }
+
+            /**
+             * @brief key of a group
+             */
+            const KeyType& key(size_type group) const {
+                return _keys[group];
+            }
+
+            /**
+             * @brief number of indices in a group
+             */
+            size_type group_size(size_type group) const {
+                return _members[group].size();
+            }
+
+            /**
+             * @brief kth index in a group (the order is arbitrary)
+             */
+            size_type member(size_type group, size_type k) const {
+                assert(k < _members[group].size());
+                return _members[group][k];
+            }
+
+            /**
+             * @brief group of ith index (npos if it is not grouped)
+             */
+            size_type group_of(size_type i) const {
+                return _group_of[i];
+            }
+
+        private:
+
+            /**
+             * @brief remove ith index from its group by moving the last member to its position
+             */
+            void remove(size_type i) {
+                const size_type group = _group_of[i];
+                if (group == npos) {
+                    return;
+                }
+                auto& members = _members[group];
+                const size_type last = members.back();
+                members[_position[i]] = last;
+                _position[last] = _position[i];
+                members.pop_back();
+                _group_of[i] = npos;
+            }
+
+            std::vector<size_type> _group_of;
+            std::vector<size_type> _position;
+            std::vector<KeyType> _keys;
+            std::vector<std::vector<size_type>> _members;
+            std::unordered_map<KeyType, size_type> _group_index;
+        };
+
+    } // namespace utility
+} // namespace openjij
+
+#endif
@@ -0,0 +1,73 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UTILITY_PARALLEL_HPP__
+#define OPENJIJ_UTILITY_PARALLEL_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace openjij {
+    namespace utility {
+
+        /**
+         * @brief maximum number of threads used in a parallel region (1 without OpenMP)
+         */
+        inline std::size_t get_max_threads() {
+#ifdef _OPENMP
+            return static_cast<std::size_t>(omp_get_max_threads());
+#else
+            return 1;
+#endif
+        }
+
+        /**
+         * @brief index of the calling thread in the current parallel region (0 without OpenMP)
+         */
+        inline std::size_t get_thread_num() {
+#ifdef _OPENMP
+            return static_cast<std::size_t>(omp_get_thread_num());
+#else
+            return 0;
+#endif
+        }
+
+        /**
+         * @brief draw n seeds from random number engine
+         *
+         * @details each work item (site, row, slice, ...) of a parallel loop seeds its own engine with one of the seeds,
+         * so that the result depends only on the master engine and not on the number of threads.
+         *
+         * @param random_number_engine master engine
+         * @param n number of seeds
+         * @param seeds buffer to be overwritten
+         */
+        template<typename RandomNumberEngine>
+        inline void generate_seeds(RandomNumberEngine& random_number_engine, std::size_t n, std::vector<std::uint64_t>& seeds) {
+            seeds.resize(n);
+            for(std::size_t i = 0;i < n;i++) {
+                const auto upper = static_cast<std::uint64_t>(random_number_engine());
+                const auto lower = static_cast<std::uint64_t>(random_number_engine());
+                seeds[i] = (upper << 32) ^ lower;
+            }
+        }
+    } // namespace utility
+} // namespace openjij
+
+#endif
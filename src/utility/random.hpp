@@ -16,7 +16,15 @@
 #define OPENJIJ_UTILITY_XORSHIFT_HPP__
 
 #include <random>
+#include <array>
 #include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifdef USE_CUDA
 #include <cuda_runtime.h>
@@ -84,10 +92,483 @@ namespace openjij {
                 Xorshift(unsigned s){
                     w=s;
                 } 
+
+                /**
+                 * @brief engines with the same state generate the same sequence
+                 */
+                friend bool operator==(const Xorshift& lhs, const Xorshift& rhs){
+                    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z && lhs.w == rhs.w;
+                }
+
+                friend bool operator!=(const Xorshift& lhs, const Xorshift& rhs){
+                    return !(lhs == rhs);
+                }
+
+                /**
+                 * @brief write the internal state as text (like the engines in <random>)
+                 */
+                friend std::ostream& operator<<(std::ostream& os, const Xorshift& engine){
+                    return os << engine.x << ' ' << engine.y << ' ' << engine.z << ' ' << engine.w;
+                }
+
+                /**
+                 * @brief read the internal state written by operator<<
+                 */
+                friend std::istream& operator>>(std::istream& is, Xorshift& engine){
+                    unsigned x, y, z, w;
+                    if(is >> x >> y >> z >> w){
+                        engine.x = x;
+                        engine.y = y;
+                        engine.z = z;
+                        engine.w = w;
+                    }
+                    return is;
+                }
             private:
                 unsigned x=123456789u,y=362436069u,z=521288629u,w;
         };
 
+        /**
+         * @brief splitmix64 random generator for c++11 random
+         *
+         * @details the state is a single 64bit word, so that it is cheap to construct one engine for each work item of a parallel loop
+         */
+        class SplitMix64{
+            public:
+                using result_type = std::uint64_t;
+
+                /**
+                 * @brief returns minimum value
+                 *
+                 * @return minimum value
+                 */
+                inline static constexpr result_type min(){
+                    return 0u;
+                }
+
+                /**
+                 * @brief returns maximum value
+                 *
+                 * @return maximum value
+                 */
+                inline static constexpr result_type max(){
+                    return UINT64_MAX;
+                }
+
+                /**
+                 * @brief generate random number
+                 *
+                 * @return random number
+                 */
+                inline result_type operator()(){
+                    return mix(state += 0x9e3779b97f4a7c15ull);
+                }
+
+                /**
+                 * @brief stateless 64bit mixing function (finalizer of splitmix64)
+                 *
+                 * @param z
+                 *
+                 * @return mixed bits
+                 */
+                inline static constexpr result_type mix(result_type z){
+                    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                    return z ^ (z >> 31);
+                }
+
+                /**
+                 * @brief SplitMix64 constructor with seed
+                 *
+                 * @param s seed
+                 */
+                explicit SplitMix64(result_type s) : state(s) {}
+
+                /**
+                 * @brief engines with the same state generate the same sequence
+                 */
+                friend bool operator==(const SplitMix64& lhs, const SplitMix64& rhs){
+                    return lhs.state == rhs.state;
+                }
+
+                friend bool operator!=(const SplitMix64& lhs, const SplitMix64& rhs){
+                    return !(lhs == rhs);
+                }
+
+                /**
+                 * @brief write the internal state as text (like the engines in <random>)
+                 */
+                friend std::ostream& operator<<(std::ostream& os, const SplitMix64& engine){
+                    return os << engine.state;
+                }
+
+                /**
+                 * @brief read the internal state written by operator<<
+                 */
+                friend std::istream& operator>>(std::istream& is, SplitMix64& engine){
+                    result_type state;
+                    if(is >> state){
+                        engine.state = state;
+                    }
+                    return is;
+                }
+            private:
+                result_type state;
+        };
+
+        /**
+         * @brief xoshiro256** random generator for c++11 random
+         *
+         * @details jump() and long_jump() advance the state by 2^128 and 2^192 numbers,
+         * which split the period 2^256-1 into non-overlapping substreams (e.g. one for each thread or replica).
+         * see D. Blackman and S. Vigna, "Scrambled linear pseudorandom number generators" (2021).
+         */
+        class Xoshiro256StarStar{
+            public:
+                using result_type = std::uint64_t;
+
+                /**
+                 * @brief returns minimum value
+                 *
+                 * @return minimum value
+                 */
+                inline static constexpr result_type min(){
+                    return 0u;
+                }
+
+                /**
+                 * @brief returns maximum value
+                 *
+                 * @return maximum value
+                 */
+                inline static constexpr result_type max(){
+                    return UINT64_MAX;
+                }
+
+                /**
+                 * @brief generate random number
+                 *
+                 * @return random number
+                 */
+                inline result_type operator()(){
+                    const result_type result = rotl(state[1] * 5, 7) * 9;
+                    const result_type t = state[1] << 17;
+                    state[2] ^= state[0];
+                    state[3] ^= state[1];
+                    state[1] ^= state[2];
+                    state[0] ^= state[3];
+                    state[2] ^= t;
+                    state[3] = rotl(state[3], 45);
+                    return result;
+                }
+
+                /**
+                 * @brief advance the state by 2^128 numbers
+                 */
+                inline void jump(){
+                    constexpr result_type polynomial[] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+                    jump_by(polynomial);
+                }
+
+                /**
+                 * @brief advance the state by 2^192 numbers
+                 */
+                inline void long_jump(){
+                    constexpr result_type polynomial[] = {0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull};
+                    jump_by(polynomial);
+                }
+
+                /**
+                 * @brief Xoshiro256StarStar constructor
+                 */
+                Xoshiro256StarStar() : Xoshiro256StarStar((static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}()) {}
+
+                /**
+                 * @brief Xoshiro256StarStar constructor with seed
+                 *
+                 * @details the state is filled by SplitMix64, so that it is never all zero.
+                 *
+                 * @param s seed
+                 */
+                explicit Xoshiro256StarStar(std::uint64_t s){
+                    SplitMix64 seeder(s);
+                    for(auto& word : state){
+                        word = seeder();
+                    }
+                }
+
+                /**
+                 * @brief Xoshiro256StarStar constructor with the state itself
+                 *
+                 * @param state state (must not be all zero)
+                 */
+                explicit Xoshiro256StarStar(const std::array<result_type, 4>& state) : state(state) {}
+
+                /**
+                 * @brief engines with the same state generate the same sequence
+                 */
+                friend bool operator==(const Xoshiro256StarStar& lhs, const Xoshiro256StarStar& rhs){
+                    return lhs.state == rhs.state;
+                }
+
+                friend bool operator!=(const Xoshiro256StarStar& lhs, const Xoshiro256StarStar& rhs){
+                    return !(lhs == rhs);
+                }
+
+                /**
+                 * @brief write the internal state as text (like the engines in <random>)
+                 */
+                friend std::ostream& operator<<(std::ostream& os, const Xoshiro256StarStar& engine){
+                    return os << engine.state[0] << ' ' << engine.state[1] << ' ' << engine.state[2] << ' ' << engine.state[3];
+                }
+
+                /**
+                 * @brief read the internal state written by operator<<
+                 */
+                friend std::istream& operator>>(std::istream& is, Xoshiro256StarStar& engine){
+                    std::array<result_type, 4> state;
+                    if(is >> state[0] >> state[1] >> state[2] >> state[3]){
+                        engine.state = state;
+                    }
+                    return is;
+                }
+            private:
+                inline static constexpr result_type rotl(result_type x, int k){
+                    return (x << k) | (x >> (64 - k));
+                }
+
+                /**
+                 * @brief advance the state by the jump polynomial
+                 */
+                inline void jump_by(const result_type (&polynomial)[4]){
+                    std::array<result_type, 4> jumped = {};
+                    for(result_type word : polynomial){
+                        for(int bit = 0; bit < 64; bit++){
+                            if(word & (result_type(1) << bit)){
+                                for(std::size_t i = 0; i < state.size(); i++){
+                                    jumped[i] ^= state[i];
+                                }
+                            }
+                            (*this)();
+                        }
+                    }
+                    state = jumped;
+                }
+
+                std::array<result_type, 4> state;
+        };
+
+        /**
+         * @brief true if the engine has jump()
+         */
+        template<typename RandomNumberEngine, typename = void>
+        struct has_jump : std::false_type {};
+
+        template<typename RandomNumberEngine>
+        struct has_jump<RandomNumberEngine, std::void_t<decltype(std::declval<RandomNumberEngine&>().jump())>> : std::true_type {};
+
+        /**
+         * @brief non-overlapping substreams of a master engine
+         *
+         * @param random_number_engine master engine (the first substream)
+         * @param n number of substreams
+         *
+         * @return engines, each of which is advanced by one jump() from the previous one
+         */
+        template<typename RandomNumberEngine>
+        inline std::vector<RandomNumberEngine> make_substreams(const RandomNumberEngine& random_number_engine, std::size_t n){
+            static_assert(has_jump<RandomNumberEngine>::value, "random number engine must have jump()");
+            std::vector<RandomNumberEngine> engines;
+            engines.reserve(n);
+            auto engine = random_number_engine;
+            for(std::size_t i = 0; i < n; i++){
+                engines.push_back(engine);
+                engine.jump();
+            }
+            return engines;
+        }
+
+        /**
+         * @brief Philox4x32-10 counter-based random generator for c++11 random
+         *
+         * @details the n-th block of four outputs is a bijection (10 rounds) of the 128bit counter (n, stream) under the 64bit key (seed).
+         * thus an engine for each replica or work item is obtained by its stream id without drawing seeds from a master engine,
+         * and different streams never overlap (2^66 outputs for each stream).
+         * see J. K. Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC11).
+         */
+        class Philox4x32{
+            public:
+                using result_type = std::uint32_t;
+                using counter_type = std::array<std::uint32_t, 4>;
+                using key_type = std::array<std::uint32_t, 2>;
+
+                /**
+                 * @brief returns minimum value
+                 *
+                 * @return minimum value
+                 */
+                inline static constexpr result_type min(){
+                    return 0u;
+                }
+
+                /**
+                 * @brief returns maximum value
+                 *
+                 * @return maximum value
+                 */
+                inline static constexpr result_type max(){
+                    return UINT32_MAX;
+                }
+
+                /**
+                 * @brief generate random number
+                 *
+                 * @return random number
+                 */
+                inline result_type operator()(){
+                    if(index == block_size){
+                        refill();
+                    }
+                    return output[index++];
+                }
+
+                /**
+                 * @brief skip z random numbers in O(1)
+                 *
+                 * @param z number of random numbers to be skipped
+                 */
+                inline void discard(unsigned long long z){
+                    const std::size_t remaining = block_size - index;
+                    if(z <= remaining){
+                        index += z;
+                        return;
+                    }
+                    z -= remaining;
+                    counter += z / block_size;
+                    index = block_size;
+                    if(z % block_size != 0){
+                        refill();
+                        index = z % block_size;
+                    }
+                }
+
+                /**
+                 * @brief Philox4x32-10 bijection
+                 *
+                 * @param ctr counter
+                 * @param key key
+                 *
+                 * @return four random numbers
+                 */
+                inline static counter_type block(counter_type ctr, key_type key){
+                    for(std::size_t round = 0; round < num_rounds; round++){
+                        if(round > 0){
+                            key[0] += 0x9e3779b9u;
+                            key[1] += 0xbb67ae85u;
+                        }
+                        const std::uint64_t product0 = static_cast<std::uint64_t>(0xd2511f53u) * ctr[0];
+                        const std::uint64_t product1 = static_cast<std::uint64_t>(0xcd9e8d57u) * ctr[2];
+                        ctr = {{
+                            static_cast<std::uint32_t>(product1 >> 32) ^ ctr[1] ^ key[0],
+                            static_cast<std::uint32_t>(product1),
+                            static_cast<std::uint32_t>(product0 >> 32) ^ ctr[3] ^ key[1],
+                            static_cast<std::uint32_t>(product0)
+                        }};
+                    }
+                    return ctr;
+                }
+
+                /**
+                 * @brief Philox4x32 constructor
+                 */
+                Philox4x32() : Philox4x32((static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}()) {}
+
+                /**
+                 * @brief Philox4x32 constructor with seed and stream id
+                 *
+                 * @param s seed
+                 * @param stream_id stream id (e.g. index of replica)
+                 */
+                explicit Philox4x32(std::uint64_t s, std::uint64_t stream_id = 0)
+                    : key{{static_cast<std::uint32_t>(s), static_cast<std::uint32_t>(s >> 32)}}, stream_id(stream_id) {}
+
+                /**
+                 * @brief returns stream id
+                 *
+                 * @return stream id
+                 */
+                inline std::uint64_t stream() const {
+                    return stream_id;
+                }
+
+                /**
+                 * @brief engines with the same state generate the same sequence
+                 */
+                friend bool operator==(const Philox4x32& lhs, const Philox4x32& rhs){
+                    return lhs.key == rhs.key && lhs.stream_id == rhs.stream_id && lhs.counter == rhs.counter && lhs.index == rhs.index;
+                }
+
+                friend bool operator!=(const Philox4x32& lhs, const Philox4x32& rhs){
+                    return !(lhs == rhs);
+                }
+
+                /**
+                 * @brief write the internal state as text (like the engines in <random>)
+                 */
+                friend std::ostream& operator<<(std::ostream& os, const Philox4x32& engine){
+                    return os << engine.key[0] << ' ' << engine.key[1] << ' ' << engine.stream_id << ' ' << engine.counter << ' ' << engine.index;
+                }
+
+                /**
+                 * @brief read the internal state written by operator<<
+                 */
+                friend std::istream& operator>>(std::istream& is, Philox4x32& engine){
+                    key_type key;
+                    std::uint64_t stream_id, counter;
+                    std::size_t index;
+                    if(is >> key[0] >> key[1] >> stream_id >> counter >> index){
+                        if(index > block_size || (index < block_size && counter == 0)){
+                            is.setstate(std::ios::failbit);
+                            return is;
+                        }
+                        engine.key = key;
+                        engine.stream_id = stream_id;
+                        engine.index = block_size;
+                        if(index < block_size){
+                            //regenerate the current block
+                            engine.counter = counter - 1;
+                            engine.refill();
+                            engine.index = index;
+                        }
+                        else{
+                            engine.counter = counter;
+                        }
+                    }
+                    return is;
+                }
+            private:
+                static constexpr std::size_t block_size = 4;
+                static constexpr std::size_t num_rounds = 10;
+
+                /**
+                 * @brief generate the block of the current counter and increment the counter
+                 */
+                inline void refill(){
+                    output = block({{static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32),
+                                     static_cast<std::uint32_t>(stream_id), static_cast<std::uint32_t>(stream_id >> 32)}}, key);
+                    ++counter;
+                    index = 0;
+                }
+
+                key_type key;
+                std::uint64_t stream_id;
+                //index of the next block
+                std::uint64_t counter = 0;
+                counter_type output = {};
+                //index of the next output in the current block (block_size: empty)
+                std::size_t index = block_size;
+        };
+
 #ifdef USE_CUDA
         namespace cuda {
             template<typename FloatType>
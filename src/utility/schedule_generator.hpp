@@ -0,0 +1,326 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UTILITY_SCHEDULE_GENERATOR_HPP__
+#define OPENJIJ_UTILITY_SCHEDULE_GENERATOR_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <system/system.hpp>
+#include <utility/schedule_list.hpp>
+
+namespace openjij {
+    namespace utility {
+
+        /* curves: value of the annealing parameter at each schedule index, computed on the fly */
+
+        /**
+         * @brief arithmetic sequence from begin to end
+         */
+        struct LinearCurve {
+            LinearCurve(double begin, double end, std::size_t num_call_updater)
+                : begin(begin), end(end), num_call_updater(num_call_updater) {}
+
+            inline std::size_t size() const {
+                return num_call_updater;
+            }
+
+            inline double operator()(std::size_t index) const {
+                return (num_call_updater < 2) ? begin
+                    : begin + (end - begin) * (static_cast<double>(index) / static_cast<double>(num_call_updater - 1));
+            }
+
+            double begin;
+            double end;
+            std::size_t num_call_updater;
+        };
+
+        /**
+         * @brief geometric sequence from begin to end (both must be positive)
+         */
+        struct GeometricCurve {
+            GeometricCurve(double begin, double end, std::size_t num_call_updater)
+                : begin(begin), end(end), num_call_updater(num_call_updater) {
+                if(!(begin > 0 && end > 0)) {
+                    throw std::invalid_argument("geometric schedule needs positive begin and end");
+                }
+            }
+
+            inline std::size_t size() const {
+                return num_call_updater;
+            }
+
+            inline double operator()(std::size_t index) const {
+                // computed from the index (not by repeated multiplication) so that rounding errors do not accumulate
+                return (num_call_updater < 2) ? begin
+                    : begin * std::pow(end / begin, static_cast<double>(index) / static_cast<double>(num_call_updater - 1));
+            }
+
+            double begin;
+            double end;
+            std::size_t num_call_updater;
+        };
+
+        /**
+         * @brief power-law curve begin + (end - begin) * t^exponent with t from 0 to 1
+         */
+        struct PowerCurve {
+            PowerCurve(double begin, double end, double exponent, std::size_t num_call_updater)
+                : begin(begin), end(end), exponent(exponent), num_call_updater(num_call_updater) {
+                if(!(exponent > 0)) {
+                    throw std::invalid_argument("power-law schedule needs a positive exponent");
+                }
+            }
+
+            inline std::size_t size() const {
+                return num_call_updater;
+            }
+
+            inline double operator()(std::size_t index) const {
+                return (num_call_updater < 2) ? begin
+                    : begin + (end - begin) * std::pow(static_cast<double>(index) / static_cast<double>(num_call_updater - 1), exponent);
+            }
+
+            double begin;
+            double end;
+            double exponent;
+            std::size_t num_call_updater;
+        };
+
+        /**
+         * @brief piecewise linear curve through knots (schedule index, value)
+         *
+         * @details the indices of the knots must start at 0 and be strictly increasing.
+         * the number of schedules is the last index + 1.
+         */
+        struct PiecewiseLinearCurve {
+            using Knot = std::pair<std::size_t, double>;
+
+            explicit PiecewiseLinearCurve(std::vector<Knot> knots) : knots(std::move(knots)) {
+                if(this->knots.empty() || this->knots.front().first != 0) {
+                    throw std::invalid_argument("piecewise schedule needs a knot at index 0");
+                }
+                for(std::size_t k = 1; k < this->knots.size(); k++) {
+                    if(this->knots[k-1].first >= this->knots[k].first) {
+                        throw std::invalid_argument("indices of knots must be strictly increasing, index="+std::to_string(this->knots[k].first));
+                    }
+                }
+            }
+
+            inline std::size_t size() const {
+                return knots.back().first + 1;
+            }
+
+            inline double operator()(std::size_t index) const {
+                // first knot after index
+                auto next = std::upper_bound(knots.begin(), knots.end(), index,
+                        [](std::size_t i, const Knot& knot){return i < knot.first;});
+                if(next == knots.end()) {
+                    return knots.back().second;
+                }
+                const auto& prev = *std::prev(next);
+                const double t = static_cast<double>(index - prev.first) / static_cast<double>(next->first - prev.first);
+                return prev.second + (next->second - prev.second) * t;
+            }
+
+            std::vector<Knot> knots;
+        };
+
+        /* schedule generators: lazy counterpart of ScheduleList */
+
+        /**
+         * @brief tag of schedule generators
+         */
+        struct schedule_generator_tag {};
+
+        /**
+         * @brief true if T is a schedule generator
+         */
+        template<typename T>
+        using is_schedule_generator = std::is_base_of<schedule_generator_tag, typename std::decay<T>::type>;
+
+        /**
+         * @brief schedule generator, which gives the schedule at each index on the fly instead of storing a ScheduleList
+         *
+         * @details it has size() and operator[] like ScheduleList and can be iterated in the same way.
+         *
+         * @tparam SystemType system type
+         * @tparam Curve curve of the annealing parameter (LinearCurve, GeometricCurve, PowerCurve, PiecewiseLinearCurve)
+         */
+        template<typename SystemType, typename Curve>
+        struct ScheduleGenerator;
+
+        /**
+         * @brief forward iterator over a schedule generator (dereferences to a Schedule by value)
+         */
+        template<typename Generator>
+        class ScheduleGeneratorIterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename Generator::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = value_type;
+
+            ScheduleGeneratorIterator(const Generator& generator, std::size_t index) : generator(&generator), index(index) {}
+
+            inline value_type operator*() const {
+                return (*generator)[index];
+            }
+
+            inline ScheduleGeneratorIterator& operator++() {
+                ++index;
+                return *this;
+            }
+
+            inline ScheduleGeneratorIterator operator++(int) {
+                auto temp = *this;
+                ++index;
+                return temp;
+            }
+
+            inline bool operator==(const ScheduleGeneratorIterator& rhs) const {
+                return index == rhs.index;
+            }
+
+            inline bool operator!=(const ScheduleGeneratorIterator& rhs) const {
+                return index != rhs.index;
+            }
+
+        private:
+            const Generator* generator;
+            std::size_t index;
+        };
+
+        /**
+         * @brief common part of schedule generators
+         */
+        template<typename Derived, typename SystemType, typename Curve>
+        struct ScheduleGeneratorBase : schedule_generator_tag {
+            using system_type = SystemType;
+            using value_type = Schedule<SystemType>;
+            using const_iterator = ScheduleGeneratorIterator<Derived>;
+
+            ScheduleGeneratorBase(const Curve& curve, std::size_t one_mc_step) : curve(curve), one_mc_step(one_mc_step) {}
+
+            inline std::size_t size() const {
+                return curve.size();
+            }
+
+            inline bool empty() const {
+                return size() == 0;
+            }
+
+            inline const_iterator begin() const {
+                return const_iterator(static_cast<const Derived&>(*this), 0);
+            }
+
+            inline const_iterator end() const {
+                return const_iterator(static_cast<const Derived&>(*this), size());
+            }
+
+            /**
+             * @brief generate the whole schedule list
+             */
+            ScheduleList<SystemType> materialize() const {
+                return ScheduleList<SystemType>(begin(), end());
+            }
+
+            /**
+             * @brief curve of the annealing parameter
+             */
+            Curve curve;
+
+            /**
+             * @brief number of mc step for each schedule
+             */
+            std::size_t one_mc_step;
+        };
+
+        /**
+         * @brief schedule generator for classical ising system (the curve gives beta)
+         */
+        template<typename Curve>
+        struct ScheduleGenerator<system::classical_system, Curve>
+            : ScheduleGeneratorBase<ScheduleGenerator<system::classical_system, Curve>, system::classical_system, Curve> {
+            using Base = ScheduleGeneratorBase<ScheduleGenerator<system::classical_system, Curve>, system::classical_system, Curve>;
+
+            ScheduleGenerator(const Curve& curve, std::size_t one_mc_step) : Base(curve, one_mc_step) {}
+
+            inline Schedule<system::classical_system> operator[](std::size_t index) const {
+                Schedule<system::classical_system> schedule;
+                schedule.updater_parameter = ClassicalUpdaterParameter(this->curve(index));
+                schedule.one_mc_step = this->one_mc_step;
+                return schedule;
+            }
+        };
+
+        /**
+         * @brief schedule generator for transverse field system (the curve gives s, beta is fixed)
+         */
+        template<typename Curve>
+        struct ScheduleGenerator<system::transverse_field_system, Curve>
+            : ScheduleGeneratorBase<ScheduleGenerator<system::transverse_field_system, Curve>, system::transverse_field_system, Curve> {
+            using Base = ScheduleGeneratorBase<ScheduleGenerator<system::transverse_field_system, Curve>, system::transverse_field_system, Curve>;
+
+            ScheduleGenerator(double beta, const Curve& curve, std::size_t one_mc_step) : Base(curve, one_mc_step), beta(beta) {}
+
+            inline Schedule<system::transverse_field_system> operator[](std::size_t index) const {
+                Schedule<system::transverse_field_system> schedule;
+                schedule.updater_parameter = TransverseFieldUpdaterParameter(beta, this->curve(index));
+                schedule.one_mc_step = this->one_mc_step;
+                return schedule;
+            }
+
+            /**
+             * @brief inverse temperature
+             */
+            double beta;
+        };
+
+        /**
+         * @brief helper function for making classical schedule generator
+         *
+         * @param curve curve of beta
+         * @param one_mc_step number of mc step for each temperature
+         */
+        template<typename Curve>
+        ScheduleGenerator<system::classical_system, Curve> make_classical_schedule_generator(const Curve& curve, std::size_t one_mc_step) {
+            return ScheduleGenerator<system::classical_system, Curve>(curve, one_mc_step);
+        }
+
+        /**
+         * @brief helper function for making transverse field system schedule generator
+         *
+         * @param beta inverse temperature
+         * @param curve curve of annealing schedule (s)
+         * @param one_mc_step number of mc step for each schedule
+         */
+        template<typename Curve>
+        ScheduleGenerator<system::transverse_field_system, Curve> make_transverse_field_schedule_generator(double beta, const Curve& curve, std::size_t one_mc_step) {
+            return ScheduleGenerator<system::transverse_field_system, Curve>(beta, curve, one_mc_step);
+        }
+
+    } // namespace utility
+} // namespace openjij
+
+#endif
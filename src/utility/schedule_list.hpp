@@ -141,6 +141,21 @@ namespace openjij {
         template<typename SystemType>
         using ScheduleList = std::vector<Schedule<SystemType>>;
 
+        /**
+         * @brief position in a schedule list, to resume a run
+         */
+        struct SchedulePosition {
+            /**
+             * @brief index of the current schedule
+             */
+            std::size_t schedule_index = 0;
+
+            /**
+             * @brief number of Monte Carlo steps done in the current schedule
+             */
+            std::size_t step = 0;
+        };
+
         /**
          * @brief ClassicalScheduleList alias
          */
@@ -0,0 +1,139 @@
+//    Copyright 2019 Jij Inc.
+
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+
+//        http://www.apache.org/licenses/LICENSE-2.0
+
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#ifndef OPENJIJ_UTILITY_SUM_TREE_HPP__
+#define OPENJIJ_UTILITY_SUM_TREE_HPP__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace openjij {
+    namespace utility {
+
+        /**
+         * @brief binary tree of partial sums of nonnegative weights.
+         * a weight is updated and an index is sampled in proportion to the weights in O(log n).
+         *
+         * @details each inner node is recomputed from its children (not incremented),
+         * so that rounding errors do not accumulate over many updates.
+         */
+        struct SumTree {
+            using size_type = std::size_t;
+
+            explicit SumTree(size_type n = 0) {
+                reset(n);
+            }
+
+            /**
+             * @brief set n weights to zero, reusing the already allocated storage
+             *
+             * @param n number of weights
+             */
+            void reset(size_type n) {
+                _size = n;
+                _capacity = 1;
+                while (_capacity < n) {
+                    _capacity <<= 1;
+                }
+                _tree.assign(2*_capacity, 0.0);
+            }
+
+            /**
+             * @brief number of weights
+             */
+            size_type size() const {
+                return _size;
+            }
+
+            /**
+             * @brief ith weight
+             */
+            double weight(size_type i) const {
+                assert(i < _size);
+                return _tree[_capacity + i];
+            }
+
+            /**
+             * @brief sum of all the weights
+             */
+            double total() const {
+                return _tree[1];
+            }
+
+            /**
+             * @brief set ith weight in O(log n)
+             *
+             * @param i index
+             * @param value nonnegative weight
+             */
+            void set(size_type i, double value) {
+                assert(i < _size && value >= 0);
+                size_type node = _capacity + i;
+                _tree[node] = value;
+                for (node >>= 1; node > 0; node >>= 1) {
+                    _tree[node] = _tree[2*node] + _tree[2*node+1];
+                }
+            }
+
+            /**
+             * @brief set the weights at leaves, then build the inner nodes in O(n)
+             *
+             * @param weights nonnegative weights (the size must be size())
+             */
+            void assign(const std::vector<double>& weights) {
+                assert(weights.size() == _size);
+                std::fill(_tree.begin(), _tree.end(), 0.0);
+                for (size_type i = 0; i < _size; ++i) {
+                    _tree[_capacity + i] = weights[i];
+                }
+                for (size_type node = _capacity - 1; node > 0; --node) {
+                    _tree[node] = _tree[2*node] + _tree[2*node+1];
+                }
+            }
+
+            /**
+             * @brief index i such that the sum of the weights before i is <= u < the sum up to i
+             *
+             * @param u value in [0, total())
+             *
+             * @return index with a positive weight (if total() is positive)
+             */
+            size_type find(double u) const {
+                size_type node = 1;
+                while (node < _capacity) {
+                    const size_type left = 2*node;
+                    // go left also if rounding errors lead to an empty right subtree
+                    if (u < _tree[left] || _tree[left+1] <= 0) {
+                        node = left;
+                    }
+                    else {
+                        u -= _tree[left];
+                        node = left + 1;
+                    }
+                }
+                return node - _capacity;
+            }
+
+        private:
+            size_type _size = 0;
+            size_type _capacity = 1;
+            std::vector<double> _tree;
+        };
+
+    } // namespace utility
+} // namespace openjij
+
+#endif
@@ -16,8 +16,10 @@
 #define OPENJIJ_UTILITY_UNION_FIND_HPP__
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 namespace openjij {
@@ -33,6 +35,17 @@ namespace openjij {
                     std::iota(_parent.begin(), _parent.end(), 0);
                 }
 
+            /**
+             * @brief make n singleton sets again, reusing the already allocated storage
+             *
+             * @param n number of nodes
+             */
+            void reset(size_type n) {
+                _parent.resize(n);
+                std::iota(_parent.begin(), _parent.end(), 0);
+                _rank.assign(n, 0);
+            }
+
             void unite_sets(Node x, Node y) {
                 auto root_x = find_set(x);
                 auto root_y = find_set(y);
@@ -79,6 +92,85 @@ namespace openjij {
             Parent _parent;
             Rank _rank;
         };
+
+        /**
+         * @brief union-find tree which can be united and searched from multiple threads at the same time
+         *
+         * @details the root with the larger index is always linked under the other one,
+         * so the root of each set is its smallest node regardless of the order of unite_sets calls.
+         */
+        struct ConcurrentUnionFind {
+            using Node = std::size_t;
+            using Parent = std::vector<std::atomic<Node>>;
+            using size_type = Parent::size_type;
+
+            explicit ConcurrentUnionFind(size_type n)
+                : _parent(n) {
+                    reset(n);
+                }
+
+            ConcurrentUnionFind(const ConcurrentUnionFind& obj)
+                : _parent(obj._parent.size()) {
+                    for (size_type node = 0; node < _parent.size(); ++node) {
+                        _parent[node].store(obj._parent[node].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    }
+                }
+
+            ConcurrentUnionFind& operator=(const ConcurrentUnionFind& obj) {
+                if (this != &obj) {
+                    if (_parent.size() != obj._parent.size()) _parent = Parent(obj._parent.size());
+                    for (size_type node = 0; node < _parent.size(); ++node) {
+                        _parent[node].store(obj._parent[node].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    }
+                }
+                return *this;
+            }
+
+            /**
+             * @brief make n singleton sets again (not thread safe)
+             *
+             * @param n number of nodes
+             */
+            void reset(size_type n) {
+                if (_parent.size() != n) _parent = Parent(n);
+                for (size_type node = 0; node < n; ++node) {
+                    _parent[node].store(node, std::memory_order_relaxed);
+                }
+            }
+
+            void unite_sets(Node x, Node y) {
+                while (true) {
+                    auto root_x = find_set(x);
+                    auto root_y = find_set(y);
+
+                    if (root_x == root_y) return;
+                    if (root_x < root_y) std::swap(root_x, root_y);
+
+                    // link root_x under root_y unless another thread has linked root_x in the meantime
+                    auto expected = root_x;
+                    if (_parent[root_x].compare_exchange_strong(expected, root_y)) return;
+                    x = root_x;
+                    y = root_y;
+                }
+            }
+
+            Node find_set(Node node) {
+                while (true) {
+                    auto parent_node = _parent[node].load();
+                    if (parent_node == node) return node;
+
+                    // do path halving
+                    auto grandparent_node = _parent[parent_node].load();
+                    if (grandparent_node != parent_node) {
+                        _parent[node].compare_exchange_weak(parent_node, grandparent_node);
+                    }
+                    node = grandparent_node;
+                }
+            }
+
+        private:
+            Parent _parent;
+        };
     } // namespace utility
 } // namespace openjij
 
@@ -20,6 +20,8 @@
 #include <utility/schedule_list.hpp>
 #include <utility/union_find.hpp>
 #include <utility/random.hpp>
+#include <utility/checkpoint.hpp>
+#include <utility/beta_range.hpp>
 #include <utility/gpu/memory.hpp>
 #include <utility/gpu/cublas.hpp>
 
@@ -52,6 +54,7 @@ static openjij::utility::TransverseFieldScheduleList generate_tfm_schedule_list(
 // #####################################
 
 #include <chrono>
+#include <functional>
 
 //speed test
 //TEST(Graph, speedtest){
@@ -270,6 +273,38 @@ TEST(Graph, JSONTest){
 
 //ClassicalIsing tests
 
+TEST(Graph, EstimateBetaRange) {
+    using namespace openjij;
+
+    const auto dense = generate_interaction<graph::Dense<double>>();
+    const auto sparse = generate_interaction<graph::Sparse<double>>();
+
+    //brute force
+    double min_delta_energy = std::numeric_limits<double>::max();
+    double max_delta_energy = 0;
+    for(std::size_t i=0; i<dense.get_num_spins(); i++){
+        double sum = std::abs(dense.h(i));
+        if(dense.h(i) != 0) min_delta_energy = std::min(min_delta_energy, std::abs(dense.h(i)));
+        for(std::size_t j=0; j<dense.get_num_spins(); j++){
+            if(i == j || dense.J(i, j) == 0) continue;
+            sum += std::abs(dense.J(i, j));
+            min_delta_energy = std::min(min_delta_energy, std::abs(dense.J(i, j)));
+        }
+        max_delta_energy = std::max(max_delta_energy, sum);
+    }
+
+    for(const auto& range : {utility::estimate_delta_energy_range(dense), utility::estimate_delta_energy_range(sparse)}){
+        EXPECT_DOUBLE_EQ(min_delta_energy, range.min_delta_energy);
+        EXPECT_DOUBLE_EQ(max_delta_energy, range.max_delta_energy);
+    }
+
+    const auto beta_range = utility::estimate_beta_range(sparse);
+    EXPECT_DOUBLE_EQ(std::log(2.0)/max_delta_energy, beta_range.beta_min);
+    EXPECT_DOUBLE_EQ(std::log(100.0)/min_delta_energy, beta_range.beta_max);
+
+    EXPECT_THROW(utility::estimate_beta_range(graph::Sparse<double>(4)), std::runtime_error);
+}
+
 TEST(ClassicalIsing, GenerateTheSameEigenObject){
     using namespace openjij;
     graph::Dense<double> d(4);
@@ -326,6 +361,412 @@ TEST(SingleSpinFlip, FindTrueGroundState_ClassicalIsing_Sparse) {
     EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
 }
 
+TEST(SingleSpinFlip, FindTrueGroundState_ClassicalIsing_Sparse_Float) {
+    using namespace openjij;
+
+    //generate classical sparse system with single precision
+    const auto interaction = generate_interaction<graph::Sparse<float>>();
+    auto engine_for_spin = std::mt19937_64(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    
+    auto random_numder_engine = std::mt19937_64(1);
+    const auto schedule_list = generate_schedule_list();
+
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
+}
+
+TEST(Algorithm, ObserverIsCalledAtGivenInterval) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    const auto schedule_list = generate_schedule_list(); //100 schedules of 100 steps
+
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_numder_engine = std::mt19937(1);
+    std::size_t num_calls = 0;
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list,
+            [&num_calls](const auto&, const auto&){ num_calls++; }, 7);
+    EXPECT_EQ(10000/7, num_calls);
+
+    //the observer does not change the result
+    auto reference_ising = system::make_classical_ising(spin, interaction);
+    auto reference_engine = std::mt19937(1);
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(reference_ising, reference_engine, schedule_list);
+    EXPECT_EQ(result::get_solution(reference_ising), result::get_solution(classical_ising));
+
+    //once per schedule
+    std::vector<double> betas;
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list,
+            [&betas](const auto&, const auto& param){ betas.push_back(param.beta); },
+            algorithm::Algorithm<updater::SingleSpinFlip>::once_per_schedule);
+    ASSERT_EQ(schedule_list.size(), betas.size());
+    for(std::size_t i=0; i<betas.size(); i++){
+        EXPECT_EQ(schedule_list[i].updater_parameter.beta, betas[i]);
+    }
+}
+
+TEST(Algorithm, RunStopsByStoppingCriteria) {
+    using namespace openjij;
+    using SSF = algorithm::Algorithm<updater::SingleSpinFlip>;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    const auto schedule_list = generate_schedule_list(); //100 schedules of 100 steps
+    const double ground_state_energy = interaction.calc_energy(get_true_groundstate());
+
+    //without criteria
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_numder_engine = std::mt19937(1);
+    auto report = SSF::run(classical_ising, random_numder_engine, schedule_list, algorithm::StoppingCriteria{});
+    EXPECT_EQ(algorithm::StopReason::completed, report.reason);
+    EXPECT_EQ(10000, report.num_steps);
+    EXPECT_EQ(schedule_list.size(), report.schedule_index);
+
+    //target energy
+    algorithm::StoppingCriteria criteria;
+    criteria.target_energy = ground_state_energy + 1e-10;
+    classical_ising.reset_spins(spin);
+    report = SSF::run(classical_ising, random_numder_engine, schedule_list, criteria);
+    EXPECT_EQ(algorithm::StopReason::target_energy, report.reason);
+    EXPECT_LT(report.num_steps, 10000);
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
+
+    //frozen at low temperature
+    criteria = algorithm::StoppingCriteria{};
+    criteria.max_steps_without_acceptance = 10;
+    classical_ising.reset_spins(spin);
+    report = SSF::run(classical_ising, random_numder_engine, schedule_list, criteria);
+    EXPECT_EQ(algorithm::StopReason::no_acceptance, report.reason);
+    EXPECT_LT(report.num_steps, 10000);
+    EXPECT_EQ((report.num_steps-1)/100, report.schedule_index);
+
+    //no improvement of the best energy
+    criteria = algorithm::StoppingCriteria{};
+    criteria.max_schedules_without_improvement = 5;
+    classical_ising.reset_spins(spin);
+    report = SSF::run(classical_ising, random_numder_engine, schedule_list, criteria);
+    EXPECT_EQ(algorithm::StopReason::no_improvement, report.reason);
+    EXPECT_EQ(100*(report.schedule_index+1), report.num_steps);
+}
+
+TEST(Algorithm, SwendsenWangStopsWhenFrozen) {
+    using namespace openjij;
+    using SW = algorithm::Algorithm<updater::SwendsenWang>;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_numder_engine = std::mt19937(1);
+
+    algorithm::StoppingCriteria criteria;
+    criteria.max_steps_without_acceptance = 10;
+
+    //every spin is a cluster at infinite temperature
+    utility::ClassicalScheduleList hot_schedule_list(1);
+    hot_schedule_list[0].one_mc_step = 100;
+    hot_schedule_list[0].updater_parameter = utility::ClassicalUpdaterParameter(0.0);
+    auto report = SW::run(classical_ising, random_numder_engine, hot_schedule_list, criteria);
+    EXPECT_EQ(algorithm::StopReason::completed, report.reason);
+    EXPECT_GT(classical_ising.observables.num_accepted, 0);
+
+    //a single cluster at low temperature
+    classical_ising.reset_spins(spin);
+    report = SW::run(classical_ising, random_numder_engine, generate_schedule_list(), criteria);
+    EXPECT_EQ(algorithm::StopReason::no_acceptance, report.reason);
+    EXPECT_LT(report.num_steps, 10000);
+}
+
+//clock advanced only by ManualClockUpdater, so that the time budget is tested without the wall-clock time
+struct ManualClock {
+    using rep = std::int64_t;
+    using period = std::micro;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() {
+        return current;
+    }
+
+    static inline time_point current{};
+
+    //inverse temperature of each update
+    static inline std::vector<double> betas;
+
+    //time taken by an update at the inverse temperature
+    static inline std::function<duration(double)> time_per_step;
+};
+
+template<typename System>
+struct ManualClockUpdater {
+    template<typename RandomNumberEngine>
+    static void update(System&, RandomNumberEngine&, const openjij::utility::ClassicalUpdaterParameter& parameter) {
+        ManualClock::betas.push_back(parameter.beta);
+        ManualClock::current += ManualClock::time_per_step(parameter.beta);
+    }
+};
+
+TEST(Algorithm, RunWithinTimeBudget) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    auto classical_ising = system::make_classical_ising(interaction.gen_spin(engine_for_spin), interaction);
+
+    //only the shape of the schedule is used
+    const auto schedule_list = utility::make_schedule_list<system::classical_system>({{1.0, 1}, {2.0, 2}, {3.0, 7}});
+
+    const auto run = [&](auto time_per_step){
+        ManualClock::current = ManualClock::time_point{};
+        ManualClock::betas.clear();
+        ManualClock::time_per_step = time_per_step;
+        auto random_numder_engine = std::mt19937(1);
+        const auto num_steps = algorithm::Algorithm<ManualClockUpdater>::run(classical_ising, random_numder_engine, schedule_list, std::chrono::seconds(1), ManualClock());
+        EXPECT_EQ(ManualClock::betas.size(), num_steps);
+        //the schedules are run in order and none of them is skipped
+        EXPECT_TRUE(std::is_sorted(ManualClock::betas.begin(), ManualClock::betas.end()));
+        for(const double beta : {1.0, 2.0, 3.0}){
+            EXPECT_LT(0, std::count(ManualClock::betas.begin(), ManualClock::betas.end(), beta));
+        }
+        return std::chrono::duration<double>(ManualClock::current.time_since_epoch()).count();
+    };
+
+    //constant throughput: the budget is split as the schedule list, counting the warm-up steps once
+    EXPECT_DOUBLE_EQ(1.0, run([](double){ return ManualClock::duration(1000); }));
+    EXPECT_EQ(100, std::count(ManualClock::betas.begin(), ManualClock::betas.end(), 1.0));
+    EXPECT_EQ(200, std::count(ManualClock::betas.begin(), ManualClock::betas.end(), 2.0));
+    EXPECT_EQ(700, std::count(ManualClock::betas.begin(), ManualClock::betas.end(), 3.0));
+
+    //the throughput drops after the first schedule: the remaining schedules are rescaled
+    EXPECT_NEAR(1.0, run([](double beta){ return ManualClock::duration(beta == 1.0 ? 1000 : 2000); }), 0.15);
+
+    //the steps of the first schedule are much slower: the warm-up stays in its share
+    EXPECT_NEAR(1.0, run([](double beta){ return ManualClock::duration(beta == 1.0 ? 50000 : 1000); }), 0.15);
+
+    //the wall clock is used by default
+    auto random_numder_engine = std::mt19937(1);
+    EXPECT_LT(0, algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list, std::chrono::milliseconds(10)));
+}
+
+TEST(Algorithm, RunIsResumedFromCheckpoint) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+
+    //run half of the schedule list, save a checkpoint, and compare the rest of the run with the one from the checkpoint
+    const auto check_resume = [](auto make_system, const auto& schedule_list, auto algorithm, auto get_state, bool exact_replay){
+        auto system = make_system();
+        auto random_number_engine = utility::Xorshift(1);
+        utility::SchedulePosition position;
+        decltype(algorithm)::run_from(system, random_number_engine, schedule_list, position, 150);
+        EXPECT_EQ(1, position.schedule_index);
+        EXPECT_EQ(50, position.step);
+
+        std::stringstream checkpoint;
+        utility::save_checkpoint(checkpoint, system, random_number_engine, position, exact_replay);
+        decltype(algorithm)::run_from(system, random_number_engine, schedule_list, position);
+        EXPECT_EQ(schedule_list.size(), position.schedule_index);
+
+        auto resumed_system = make_system();
+        auto resumed_engine = utility::Xorshift(2);
+        auto resumed_position = utility::load_checkpoint(checkpoint, resumed_system, resumed_engine);
+        EXPECT_EQ(1, resumed_position.schedule_index);
+        EXPECT_EQ(50, resumed_position.step);
+        decltype(algorithm)::run_from(resumed_system, resumed_engine, schedule_list, resumed_position);
+
+        EXPECT_EQ(get_state(system), get_state(resumed_system));
+        EXPECT_EQ(random_number_engine, resumed_engine);
+    };
+
+    check_resume([&](){ return system::make_classical_ising(spin, interaction); },
+            utility::make_classical_schedule_list(0.1, 10.0, 100, 10),
+            algorithm::Algorithm<updater::SingleSpinFlip>{},
+            [](const auto& system){ return result::get_solution(system); }, false);
+
+    check_resume([&](){ return system::make_transverse_ising(spin, interaction, 1.0, 4); },
+            utility::make_transverse_field_schedule_list(10, 100, 10),
+            algorithm::Algorithm<updater::SingleSpinFlip>{},
+            [](const auto& system){ return system.trotter_spins; }, true);
+
+    check_resume([&](){ return system::make_continuous_time_ising(spin, interaction, 1.0); },
+            utility::make_transverse_field_schedule_list(10, 100, 10),
+            algorithm::Algorithm<updater::ContinuousTimeSwendsenWang>{},
+            [](const auto& system){ return system.spin_config; }, false);
+
+    //without exact replay, the local fields of transverse ising system are recomputed and the checkpoint is smaller
+    {
+        auto transverse_ising = system::make_transverse_ising(spin, interaction, 1.0, 4);
+        auto random_number_engine = utility::Xorshift(1);
+        algorithm::Algorithm<updater::SingleSpinFlip>::run(transverse_ising, random_number_engine, utility::make_transverse_field_schedule_list(10, 10, 10));
+        std::stringstream checkpoint, exact_checkpoint;
+        utility::save_checkpoint(checkpoint, transverse_ising, random_number_engine, utility::SchedulePosition{});
+        utility::save_checkpoint(exact_checkpoint, transverse_ising, random_number_engine, utility::SchedulePosition{}, true);
+        EXPECT_LT(checkpoint.str().size() + 4*num_system_size*sizeof(double), exact_checkpoint.str().size());
+
+        auto resumed_ising = system::make_transverse_ising(spin, interaction, 1.0, 4);
+        utility::load_checkpoint(checkpoint, resumed_ising, random_number_engine);
+        EXPECT_EQ(transverse_ising.trotter_spins, resumed_ising.trotter_spins);
+        EXPECT_TRUE(resumed_ising.local_field.isApprox(transverse_ising.local_field, 1e-10));
+        EXPECT_TRUE(resumed_ising.slice_energy.isApprox(transverse_ising.slice_energy, 1e-10));
+    }
+
+    //a checkpoint of another system is rejected
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_number_engine = utility::Xorshift(1);
+    std::stringstream checkpoint;
+    utility::save_checkpoint(checkpoint, classical_ising, random_number_engine, utility::SchedulePosition{});
+    auto small_ising = system::make_classical_ising(graph::Spins{1, -1}, graph::Sparse<double>(2));
+    EXPECT_THROW(utility::load_checkpoint(checkpoint, small_ising, random_number_engine), std::runtime_error);
+
+    //the kind of system and the floating point type are checked
+    checkpoint.clear();
+    checkpoint.seekg(0);
+    auto transverse_ising = system::make_transverse_ising(spin, interaction, 1.0, 4);
+    EXPECT_THROW(utility::load_checkpoint(checkpoint, transverse_ising, random_number_engine), std::runtime_error);
+    checkpoint.clear();
+    checkpoint.seekg(0);
+    auto float_ising = system::make_classical_ising(spin, generate_interaction<graph::Sparse<float>>());
+    EXPECT_THROW(utility::load_checkpoint(checkpoint, float_ising, random_number_engine), std::runtime_error);
+    checkpoint.clear();
+    checkpoint.seekg(0);
+    EXPECT_NO_THROW(utility::load_checkpoint(checkpoint, classical_ising, random_number_engine));
+}
+
+TEST(Algorithm, RunWithScheduleGenerator) {
+    using namespace openjij;
+
+    //the generators give the same schedules as the helper functions
+    const auto geometric = utility::make_classical_schedule_generator(utility::GeometricCurve(0.1, 10.0, 100), 100);
+    const auto classical_list = utility::make_classical_schedule_list(0.1, 10.0, 100, 100);
+    ASSERT_EQ(classical_list.size(), geometric.size());
+    for(std::size_t i=0; i<geometric.size(); i++){
+        EXPECT_NEAR(classical_list[i].updater_parameter.beta, geometric[i].updater_parameter.beta, 1e-9);
+        EXPECT_EQ(classical_list[i].one_mc_step, geometric[i].one_mc_step);
+    }
+    const auto linear = utility::make_transverse_field_schedule_generator(10.0, utility::LinearCurve(0, 1, 10), 100);
+    const auto transverse_list = utility::make_transverse_field_schedule_list(10.0, 100, 10);
+    ASSERT_EQ(transverse_list.size(), linear.size());
+    for(std::size_t i=0; i<linear.size(); i++){
+        EXPECT_NEAR(transverse_list[i].updater_parameter.s, linear[i].updater_parameter.s, 1e-12);
+        EXPECT_EQ(transverse_list[i].updater_parameter.beta, linear[i].updater_parameter.beta);
+    }
+
+    const auto power = utility::PowerCurve(1, 5, 2, 5);
+    EXPECT_DOUBLE_EQ(1, power(0));
+    EXPECT_DOUBLE_EQ(2, power(2));
+    EXPECT_DOUBLE_EQ(5, power(4));
+    const auto piecewise = utility::PiecewiseLinearCurve({{0, 1.0}, {4, 3.0}, {6, 3.0}});
+    EXPECT_EQ(7, piecewise.size());
+    EXPECT_DOUBLE_EQ(1.5, piecewise(1));
+    EXPECT_DOUBLE_EQ(3.0, piecewise(5));
+    EXPECT_DOUBLE_EQ(3.0, piecewise(6));
+    EXPECT_THROW(utility::PiecewiseLinearCurve({{1, 1.0}}), std::invalid_argument);
+
+    //a run with the generator is the same as the one with the materialized schedule list
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_number_engine = std::mt19937(1);
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_number_engine, geometric);
+
+    auto reference_ising = system::make_classical_ising(spin, interaction);
+    auto reference_engine = std::mt19937(1);
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(reference_ising, reference_engine, geometric.materialize());
+
+    EXPECT_EQ(result::get_solution(reference_ising), result::get_solution(classical_ising));
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
+}
+
+TEST(Algorithm, RunWithAdaptiveSchedule) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+
+    //start from a too large beta, the warm-up heats the system up
+    algorithm::AdaptiveSchedule schedule;
+    schedule.num_sweeps = 2000;
+    schedule.initial_beta = 100.0;
+    schedule.max_frozen_blocks = 0;
+
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_number_engine = std::mt19937(1);
+    const auto report = algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_number_engine, schedule);
+
+    EXPECT_EQ(schedule.num_sweeps, report.num_sweeps);
+    EXPECT_FALSE(report.frozen);
+    ASSERT_EQ(report.schedule_list.size(), report.acceptance_ratio.size());
+    ASSERT_LT(report.num_warmup_blocks, report.schedule_list.size());
+    EXPECT_LT(report.schedule_list[report.num_warmup_blocks].updater_parameter.beta, schedule.initial_beta);
+    //beta does not decrease in the annealing
+    for(std::size_t i=report.num_warmup_blocks+1; i<report.schedule_list.size(); i++){
+        EXPECT_LE(report.schedule_list[i-1].updater_parameter.beta, report.schedule_list[i].updater_parameter.beta);
+    }
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
+
+    //the run is stopped once the system is frozen
+    schedule.max_frozen_blocks = 5;
+    auto frozen_ising = system::make_classical_ising(spin, interaction);
+    const auto frozen_report = algorithm::Algorithm<updater::SingleSpinFlip>::run(frozen_ising, random_number_engine, schedule);
+    EXPECT_TRUE(frozen_report.frozen);
+    EXPECT_LT(frozen_report.num_sweeps, schedule.num_sweeps);
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(frozen_ising));
+
+    schedule.sweeps_per_block = 0;
+    EXPECT_THROW(algorithm::Algorithm<updater::SingleSpinFlip>::run(frozen_ising, random_number_engine, schedule), std::invalid_argument);
+}
+
+TEST(Algorithm, RunReplicasIsIndependentOfNumberOfThreads) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    const auto schedule_list = utility::make_classical_schedule_list(0.1, 10.0, 10, 20);
+
+    const std::size_t num_replicas = 8;
+    auto run_replicas = [&](std::size_t num_threads){
+        std::vector<system::ClassicalIsing<graph::Sparse<double>>> replicas(num_replicas, system::make_classical_ising(spin, interaction));
+#ifdef _OPENMP
+        const int max_threads = omp_get_max_threads();
+        omp_set_num_threads(static_cast<int>(num_threads));
+#else
+        (void)num_threads;
+#endif
+        algorithm::Algorithm<updater::SingleSpinFlip>::run_replicas(replicas, 1, schedule_list);
+#ifdef _OPENMP
+        omp_set_num_threads(max_threads);
+#endif
+        std::vector<graph::Spins> solutions;
+        for(const auto& replica : replicas){
+            solutions.push_back(result::get_solution(replica));
+        }
+        return solutions;
+    };
+
+    const auto solutions = run_replicas(1);
+    EXPECT_EQ(solutions, run_replicas(3));
+    EXPECT_EQ(solutions, run_replicas(num_replicas));
+
+    //replica i is the same as a sequential run with stream i
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_number_engine = utility::Philox4x32(1, num_replicas-1);
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_number_engine, schedule_list);
+    EXPECT_EQ(solutions.back(), result::get_solution(classical_ising));
+}
+
 TEST(SingleSpinFlip, FindTrueGroundState_TransverseIsing_Dense) {
     using namespace openjij;
 
@@ -376,6 +817,221 @@ TEST(SingleSpinFlip, FindTrueGroundState_TransverseIsing_Sparse) {
     EXPECT_EQ(get_true_groundstate(), result::get_solution(transverse_ising));
 }
 
+TEST(SingleSpinFlip, FindTrueGroundState_TransverseIsing_Sparse_Float) {
+    using namespace openjij;
+
+    //generate transverse sparse system with single precision
+    const auto interaction = generate_interaction<graph::Sparse<float>>();
+    auto engine_for_spin = std::mt19937(1);
+    std::size_t num_trotter_slices = 10;
+
+    system::TrotterSpins init_trotter_spins(num_trotter_slices);
+    for(auto& spins : init_trotter_spins){
+        spins = interaction.gen_spin(engine_for_spin);
+    }
+
+    auto transverse_ising = system::make_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = generate_tfm_schedule_list();
+
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(transverse_ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(transverse_ising));
+
+    //the local fields are recalculated periodically, so that the rounding errors do not accumulate
+    const std::size_t num_trotter_spins = transverse_ising.num_classical_spins * num_trotter_slices;
+    EXPECT_LE(transverse_ising.num_incremental_flips, (decltype(transverse_ising)::max_incremental_flips_per_spin + 1) * num_trotter_spins);
+    const decltype(transverse_ising)::TrotterMatrix expected = transverse_ising.interaction * transverse_ising.trotter_spins;
+    EXPECT_TRUE(transverse_ising.local_field.isApprox(expected, 1e-5));
+    EXPECT_NEAR(interaction.calc_energy(result::get_solution(transverse_ising)), result::get_energy(transverse_ising), 1e-3);
+
+    //synchronize_local_field recalculates only after enough flips
+    transverse_ising.num_incremental_flips = 0;
+    EXPECT_FALSE(transverse_ising.synchronize_local_field());
+    transverse_ising.num_incremental_flips = decltype(transverse_ising)::max_incremental_flips_per_spin * num_trotter_spins + 1;
+    EXPECT_TRUE(transverse_ising.synchronize_local_field());
+    EXPECT_EQ(0, transverse_ising.num_incremental_flips);
+}
+
+TEST(SingleSpinFlip, LocalFieldIsConsistent_TransverseIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    std::size_t num_trotter_slices = 10;
+
+    system::TrotterSpins init_trotter_spins(num_trotter_slices);
+    for(auto& spins : init_trotter_spins){
+        spins = interaction.gen_spin(engine_for_spin);
+    }
+
+    auto transverse_ising = system::make_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = utility::make_transverse_field_schedule_list(10, 10, 10);
+
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(transverse_ising, random_numder_engine, schedule_list);
+
+    const decltype(transverse_ising)::TrotterMatrix expected = transverse_ising.interaction * transverse_ising.trotter_spins;
+    EXPECT_TRUE(transverse_ising.local_field.isApprox(expected, 1e-10));
+
+    for(std::size_t t=0; t<num_trotter_slices; t++){
+        const double energy = transverse_ising.trotter_spins.col(t).transpose() * transverse_ising.interaction * transverse_ising.trotter_spins.col(t);
+        EXPECT_NEAR((energy - 1)/2, transverse_ising.slice_energy(t), 1e-10);
+    }
+}
+
+TEST(SingleSpinFlip, WorldlineFlip_TransverseIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    std::size_t num_trotter_slices = 10;
+
+    system::TrotterSpins init_trotter_spins(num_trotter_slices);
+    for(auto& spins : init_trotter_spins){
+        spins = interaction.gen_spin(engine_for_spin);
+    }
+
+    auto transverse_ising = system::make_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+    transverse_ising.worldline_flip_ratio = 0.5;
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = generate_tfm_schedule_list();
+
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(transverse_ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(transverse_ising));
+
+    const decltype(transverse_ising)::TrotterMatrix expected = transverse_ising.interaction * transverse_ising.trotter_spins;
+    EXPECT_TRUE(transverse_ising.local_field.isApprox(expected, 1e-10));
+
+    for(std::size_t t=0; t<num_trotter_slices; t++){
+        const double energy = transverse_ising.trotter_spins.col(t).transpose() * transverse_ising.interaction * transverse_ising.trotter_spins.col(t);
+        EXPECT_NEAR((energy - 1)/2, transverse_ising.slice_energy(t), 1e-10);
+    }
+}
+
+TEST(ParallelSingleSpinFlip, FindTrueGroundState_TransverseIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    std::size_t num_trotter_slices = 9; //odd number of slices
+
+    system::TrotterSpins init_trotter_spins(num_trotter_slices);
+    for(auto& spins : init_trotter_spins){
+        spins = interaction.gen_spin(engine_for_spin);
+    }
+
+    auto transverse_ising = system::make_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = generate_tfm_schedule_list();
+
+    algorithm::Algorithm<updater::ParallelSingleSpinFlip>::run(transverse_ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(transverse_ising));
+
+    const decltype(transverse_ising)::TrotterMatrix expected = transverse_ising.interaction * transverse_ising.trotter_spins;
+    EXPECT_TRUE(transverse_ising.local_field.isApprox(expected, 1e-10));
+
+    EXPECT_NEAR(interaction.calc_energy(result::get_solution(transverse_ising)), result::get_energy(transverse_ising), 1e-10);
+}
+
+TEST(ParallelSingleSpinFlip, WorldlineFlip_TransverseIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    std::size_t num_trotter_slices = 9;
+
+    system::TrotterSpins init_trotter_spins(num_trotter_slices);
+    for(auto& spins : init_trotter_spins){
+        spins = interaction.gen_spin(engine_for_spin);
+    }
+
+    const auto run_update = [&](double worldline_flip_ratio){
+        auto transverse_ising = system::make_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+        transverse_ising.worldline_flip_ratio = worldline_flip_ratio;
+        auto random_numder_engine = std::mt19937(1);
+        updater::ParallelSingleSpinFlip<decltype(transverse_ising)>::update(transverse_ising, random_numder_engine, utility::TransverseFieldUpdaterParameter(1.0, 0.5));
+        return transverse_ising;
+    };
+
+    //the worldline moves are not ignored
+    const auto local_only = run_update(0);
+    const auto transverse_ising = run_update(1.0);
+    EXPECT_NE(local_only.trotter_spins, transverse_ising.trotter_spins);
+
+    const decltype(transverse_ising)::TrotterMatrix expected = transverse_ising.interaction * transverse_ising.trotter_spins;
+    EXPECT_TRUE(transverse_ising.local_field.isApprox(expected, 1e-10));
+
+    for(std::size_t t=0; t<num_trotter_slices; t++){
+        const double energy = transverse_ising.trotter_spins.col(t).transpose() * transverse_ising.interaction * transverse_ising.trotter_spins.col(t);
+        EXPECT_NEAR((energy - 1)/2, transverse_ising.slice_energy(t), 1e-10);
+    }
+}
+
+TEST(ParallelSingleSpinFlip, ResultIsIndependentOfNumberOfThreads) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    const auto schedule_list = generate_tfm_schedule_list();
+
+    //an odd number of slices covers the last slice updated alone
+    for(const std::size_t num_trotter_slices : {9, 10}){
+        auto engine_for_spin = std::mt19937(1);
+        system::TrotterSpins init_trotter_spins(num_trotter_slices);
+        for(auto& spins : init_trotter_spins){
+            spins = interaction.gen_spin(engine_for_spin);
+        }
+
+        auto run = [&](std::size_t num_threads){
+            auto transverse_ising = system::make_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+            auto random_numder_engine = std::mt19937(1);
+#ifdef _OPENMP
+            const int max_threads = omp_get_max_threads();
+            omp_set_num_threads(static_cast<int>(num_threads));
+#else
+            (void)num_threads;
+#endif
+            algorithm::Algorithm<updater::ParallelSingleSpinFlip>::run(transverse_ising, random_numder_engine, schedule_list);
+#ifdef _OPENMP
+            omp_set_num_threads(max_threads);
+#endif
+            return transverse_ising.trotter_spins;
+        };
+
+        const auto trotter_spins = run(1);
+        EXPECT_EQ(trotter_spins, run(3));
+        EXPECT_EQ(trotter_spins, run(4));
+    }
+}
+
+TEST(SingleSpinFlip, FindTrueGroundState_PackedTransverseIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    std::size_t num_trotter_slices = 10;
+
+    system::TrotterSpins init_trotter_spins(num_trotter_slices);
+    for(auto& spins : init_trotter_spins){
+        spins = interaction.gen_spin(engine_for_spin);
+    }
+
+    auto transverse_ising = system::make_packed_transverse_ising(init_trotter_spins, interaction, 1.0); //gamma = 1.0
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = generate_tfm_schedule_list();
+
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(transverse_ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(transverse_ising));
+}
+
 //swendsen-wang test
 TEST(SwendsenWang, FindTrueGroundState_ClassicalIsing_Sparse_OneDimensionalIsing) {
     using namespace openjij;
@@ -424,6 +1080,344 @@ TEST(SwendsenWang, FindTrueGroundState_ClassicalIsing_Sparse) {
     EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
 }
 
+//n-fold way test
+TEST(NFoldWay, FindTrueGroundState_ClassicalIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = generate_schedule_list();
+
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
+}
+
+//check the local fields, the observables and the rates kept by n-fold way
+template<typename ClIsing, typename GraphType>
+static void expect_n_fold_way_is_consistent(const ClIsing& classical_ising, const GraphType& interaction) {
+    using namespace openjij;
+    const auto spins = result::get_solution(classical_ising);
+    EXPECT_NEAR(interaction.calc_energy(spins), classical_ising.observables.energy, 1e-10);
+    EXPECT_NEAR(std::accumulate(spins.begin(), spins.end(), 0.0), classical_ising.observables.magnetization, 1e-10);
+    ASSERT_EQ(classical_ising.spin_revision, classical_ising.workspace.spin_revision);
+    EXPECT_TRUE(classical_ising.workspace.local_field.isApprox(classical_ising.interaction * classical_ising.spin));
+    //the rates follow the local fields
+    const auto* n_fold_way_workspace = updater::NFoldWay<ClIsing>::find_workspace(classical_ising);
+    ASSERT_NE(nullptr, n_fold_way_workspace);
+    const auto& workspace = *n_fold_way_workspace;
+    ASSERT_EQ(classical_ising.spin_revision, workspace.spin_revision);
+    for(std::size_t i=0; i<classical_ising.num_spins; i++){
+        const double dE = -2 * classical_ising.spin(i) * classical_ising.workspace.local_field(i);
+        const double rate = (dE <= 0) ? 1.0 : std::exp(-workspace.beta * dE);
+        if(workspace.use_class_rate){
+            const auto k = workspace.delta_energy_class.group_of(i);
+            EXPECT_EQ(dE, workspace.delta_energy_class.key(k));
+            EXPECT_NEAR(rate, workspace.class_rate[k], 1e-10);
+        }
+        else{
+            EXPECT_NEAR(rate, workspace.flip_rate.weight(i), 1e-10);
+        }
+    }
+}
+
+TEST(NFoldWay, LocalFieldAndObservablesAreConsistent_ClassicalIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    auto classical_ising = system::make_classical_ising(interaction.gen_spin(engine_for_spin), interaction);
+
+    //one update corresponds to num_spins trials
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = utility::make_classical_schedule_list(0.1, 10.0, 10, 10);
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_n_fold_way_is_consistent(classical_ising, interaction);
+    EXPECT_LE(classical_ising.num_spins*100, classical_ising.observables.num_accepted + classical_ising.observables.num_rejected);
+
+    //the spins are changed by another updater (which may flip the dummy spin) or reset
+    algorithm::Algorithm<updater::SwendsenWang>::run(classical_ising, random_numder_engine, schedule_list);
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_n_fold_way_is_consistent(classical_ising, interaction);
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list);
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_n_fold_way_is_consistent(classical_ising, interaction);
+    classical_ising.reset_spins(interaction.gen_spin(engine_for_spin));
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_n_fold_way_is_consistent(classical_ising, interaction);
+
+    //the local fields are kept by steepest descent, but the rates are not
+    classical_ising.reset_spins(interaction.gen_spin(engine_for_spin));
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+    algorithm::SteepestDescent::run(classical_ising);
+    algorithm::Algorithm<updater::NFoldWay>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_n_fold_way_is_consistent(classical_ising, interaction);
+}
+
+TEST(NFoldWay, RatesAreGroupedOnlyForFewEnergyDifferences_ClassicalIsing_Sparse) {
+    using namespace openjij;
+    constexpr std::size_t L = 20;
+
+    //two-dimensional +-J model: the energy differences take a few distinct values
+    auto lattice = graph::Sparse<double>(L*L);
+    //random couplings: almost all the energy differences are distinct
+    auto random_couplings = graph::Sparse<double>(L*L);
+    auto engine_for_interaction = std::mt19937(1);
+    auto urd = std::uniform_real_distribution<>(-1.0, 1.0);
+    for(std::size_t x=0; x<L; x++){
+        for(std::size_t y=0; y<L; y++){
+            const std::size_t i = x*L + y;
+            lattice.h(i) = (i % 3 == 0) ? 1 : 0;
+            random_couplings.h(i) = urd(engine_for_interaction);
+            for(const std::size_t j : {((x+1)%L)*L + y, x*L + (y+1)%L}){
+                lattice.J(i, j) = (urd(engine_for_interaction) < 0) ? -1 : +1;
+                random_couplings.J(i, j) = urd(engine_for_interaction);
+            }
+        }
+    }
+
+    //one sweep per beta
+    const auto schedule_list = utility::make_classical_schedule_list(0.1, 10.0, 1, 200);
+    auto engine_for_spin = std::mt19937(1);
+    auto random_numder_engine = std::mt19937(1);
+
+    auto lattice_ising = system::make_classical_ising(lattice.gen_spin(engine_for_spin), lattice);
+    algorithm::Algorithm<updater::NFoldWay>::run(lattice_ising, random_numder_engine, schedule_list);
+    using NFoldWay = updater::NFoldWay<decltype(lattice_ising)>;
+    EXPECT_TRUE(NFoldWay::find_workspace(lattice_ising)->use_class_rate);
+    EXPECT_GE(NFoldWay::max_num_classes, NFoldWay::find_workspace(lattice_ising)->delta_energy_class.num_groups());
+    expect_n_fold_way_is_consistent(lattice_ising, lattice);
+
+    auto random_ising = system::make_classical_ising(random_couplings.gen_spin(engine_for_spin), random_couplings);
+    algorithm::Algorithm<updater::NFoldWay>::run(random_ising, random_numder_engine, schedule_list);
+    EXPECT_FALSE(NFoldWay::find_workspace(random_ising)->use_class_rate);
+    expect_n_fold_way_is_consistent(random_ising, random_couplings);
+
+    //both reach low energy states (the ground state energy of the lattice is about -1.4 per spin)
+    EXPECT_GT(-1.2*L*L, lattice_ising.observables.energy);
+    EXPECT_LE(lattice.calc_energy(result::get_solution(lattice_ising)), lattice_ising.observables.energy + 1e-10);
+}
+
+//tabu search test
+TEST(TabuSearch, FindTrueGroundState_ClassicalIsing) {
+    using namespace openjij;
+
+    const auto run_tabu_search = [](auto interaction){
+        auto engine_for_spin = std::mt19937(1);
+        auto classical_ising = system::make_classical_ising(interaction.gen_spin(engine_for_spin), interaction);
+        classical_ising.set_track_best_spin(true);
+
+        auto random_numder_engine = std::mt19937(1);
+        algorithm::TabuSearchParameter parameter;
+        parameter.num_iterations = 100;
+        parameter.num_restarts = 3;
+        parameter.max_stagnation = 20;
+        const auto report = algorithm::TabuSearch::run(classical_ising, random_numder_engine, parameter);
+
+        EXPECT_EQ(get_true_groundstate(), result::get_solution(classical_ising));
+        EXPECT_NEAR(interaction.calc_energy(get_true_groundstate()), report.best_energy, 1e-10);
+        //the system is left in the best spins and the observables and the local fields are consistent
+        EXPECT_NEAR(report.best_energy, classical_ising.observables.energy, 1e-10);
+        EXPECT_EQ(classical_ising.best_spin(), classical_ising.spin);
+        EXPECT_TRUE(classical_ising.workspace.local_field.isApprox(classical_ising.interaction * classical_ising.spin));
+        EXPECT_EQ(4, report.num_runs);
+        EXPECT_LE(report.num_iterations, 400);
+    };
+    run_tabu_search(generate_interaction<graph::Dense<double>>());
+    run_tabu_search(generate_interaction<graph::Sparse<double>>());
+
+    algorithm::TabuSearchParameter parameter;
+    EXPECT_EQ(5, parameter.tenure_for(16));
+    EXPECT_EQ(21, parameter.tenure_for(1000));
+    parameter.tenure = 100;
+    EXPECT_EQ(15, parameter.tenure_for(16));
+    parameter.restart_perturbation = 0;
+    EXPECT_THROW(parameter.validate(), std::invalid_argument);
+}
+
+TEST(TabuSearch, SparseSelectionFollowsDenseScan_ClassicalIsing) {
+    using namespace openjij;
+    constexpr std::size_t L = 12;
+
+    //two-dimensional lattice with random couplings: there are no ties, so that the moves do not depend on the random numbers
+    auto dense = graph::Dense<double>(L*L);
+    auto sparse = graph::Sparse<double>(L*L);
+    auto engine_for_interaction = std::mt19937(1);
+    auto urd = std::uniform_real_distribution<>(-1.0, 1.0);
+    for(std::size_t x=0; x<L; x++){
+        for(std::size_t y=0; y<L; y++){
+            const std::size_t i = x*L + y;
+            dense.h(i) = sparse.h(i) = urd(engine_for_interaction);
+            for(const std::size_t j : {((x+1)%L)*L + y, x*L + (y+1)%L}){
+                dense.J(i, j) = sparse.J(i, j) = urd(engine_for_interaction);
+            }
+        }
+    }
+
+    //a single run (restarts use random numbers)
+    algorithm::TabuSearchParameter parameter;
+    parameter.num_iterations = 2000;
+    parameter.num_restarts = 0;
+    parameter.max_stagnation = 0;
+
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = dense.gen_spin(engine_for_spin);
+    auto dense_ising = system::make_classical_ising(spin, dense);
+    auto sparse_ising = system::make_classical_ising(spin, sparse);
+    auto dense_engine = std::mt19937(1);
+    auto sparse_engine = std::mt19937(2);
+    const auto dense_report = algorithm::TabuSearch::run(dense_ising, dense_engine, parameter);
+    const auto sparse_report = algorithm::TabuSearch::run(sparse_ising, sparse_engine, parameter);
+
+    EXPECT_EQ(parameter.num_iterations, sparse_report.num_iterations);
+    EXPECT_NEAR(dense_report.best_energy, sparse_report.best_energy, 1e-10);
+    EXPECT_EQ(result::get_solution(dense_ising), result::get_solution(sparse_ising));
+    //the system is left in the best spins
+    EXPECT_NEAR(sparse.calc_energy(result::get_solution(sparse_ising)), sparse_report.best_energy, 1e-10);
+    EXPECT_NEAR(sparse_report.best_energy, sparse_ising.observables.energy, 1e-10);
+}
+
+//steepest descent test
+TEST(SteepestDescent, ReachLocalMinimum_ClassicalIsing) {
+    using namespace openjij;
+
+    const auto run_steepest_descent = [](auto interaction){
+        auto engine_for_spin = std::mt19937(1);
+        for (std::size_t trial = 0; trial < 10; ++trial) {
+            auto classical_ising = system::make_classical_ising(interaction.gen_spin(engine_for_spin), interaction);
+            const double initial_energy = classical_ising.observables.energy;
+            const auto num_flips = algorithm::SteepestDescent::run(classical_ising);
+
+            const auto spins = result::get_solution(classical_ising);
+            const double energy = interaction.calc_energy(spins);
+            EXPECT_NEAR(energy, classical_ising.observables.energy, 1e-10);
+            EXPECT_LE(energy, initial_energy);
+            EXPECT_EQ(num_flips == 0, energy == initial_energy);
+            //no single flip decreases the energy
+            for (std::size_t i = 0; i < spins.size(); ++i) {
+                auto flipped = spins;
+                flipped[i] *= -1;
+                EXPECT_GE(interaction.calc_energy(flipped), energy - 1e-10);
+            }
+            //a local minimum is kept as it is
+            EXPECT_EQ(0, algorithm::SteepestDescent::run(classical_ising));
+        }
+    };
+    run_steepest_descent(generate_interaction<graph::Dense<double>>());
+    run_steepest_descent(generate_interaction<graph::Sparse<double>>());
+}
+
+TEST(Observables, ObservablesAreConsistent_ClassicalIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    auto classical_ising = system::make_classical_ising(interaction.gen_spin(engine_for_spin), interaction);
+
+    const auto expect_consistent = [&](){
+        const auto spins = result::get_solution(classical_ising);
+        EXPECT_NEAR(interaction.calc_energy(spins), classical_ising.observables.energy, 1e-10);
+        EXPECT_NEAR(std::accumulate(spins.begin(), spins.end(), 0.0), classical_ising.observables.magnetization, 1e-10);
+        EXPECT_LE(classical_ising.observables.best_energy, classical_ising.observables.energy);
+    };
+    expect_consistent();
+
+    auto random_numder_engine = std::mt19937(1);
+    system::ObservablesHistory<double> history;
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, generate_schedule_list(), history,
+            algorithm::Algorithm<updater::SingleSpinFlip>::once_per_schedule);
+    expect_consistent();
+    EXPECT_EQ(classical_ising.num_spins*10000, classical_ising.observables.num_accepted + classical_ising.observables.num_rejected);
+    ASSERT_EQ(100, history.energy.size());
+    EXPECT_EQ(classical_ising.observables.energy, history.energy.back());
+    EXPECT_NEAR(interaction.calc_energy(get_true_groundstate()), history.best_energy.back(), 1e-10);
+    //the spins freeze at low temperature
+    EXPECT_GT(history.acceptance_ratio.front(), history.acceptance_ratio.back());
+
+    //cluster updates (may flip the dummy spin) followed by single spin flips
+    const auto schedule_list = utility::make_classical_schedule_list(0.1, 1.0, 10, 10);
+    algorithm::Algorithm<updater::SwendsenWang>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_consistent();
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_consistent();
+
+    classical_ising.reset_spins(interaction.gen_spin(engine_for_spin));
+    expect_consistent();
+    EXPECT_EQ(0, classical_ising.observables.num_accepted);
+}
+
+TEST(Observables, BestSpinIsTracked_ClassicalIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    auto classical_ising = system::make_classical_ising(interaction.gen_spin(engine_for_spin), interaction);
+    EXPECT_THROW(result::get_best_solution(classical_ising), std::runtime_error);
+
+    classical_ising.set_track_best_spin(true);
+    EXPECT_EQ(result::get_solution(classical_ising), result::get_best_solution(classical_ising));
+
+    //high temperature, so that the final state is not the best one
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = utility::make_classical_schedule_list(0.1, 1.0, 100, 10);
+    const auto expect_best = [&](){
+        const auto best_energy = interaction.calc_energy(result::get_best_solution(classical_ising));
+        EXPECT_NEAR(classical_ising.observables.best_energy, best_energy, 1e-10);
+        EXPECT_LE(best_energy, classical_ising.observables.energy);
+    };
+
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_best();
+    algorithm::Algorithm<updater::SwendsenWang>::run(classical_ising, random_numder_engine, schedule_list);
+    expect_best();
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_numder_engine, generate_schedule_list());
+    expect_best();
+    EXPECT_EQ(get_true_groundstate(), result::get_best_solution(classical_ising));
+}
+
+//houdayer test
+TEST(Houdayer, ClusterMoveKeepsTotalEnergy_Square) {
+    using namespace openjij;
+
+    //generate 2D +-J spin glass
+    auto engine_for_interaction = std::mt19937(1);
+    auto uid = std::uniform_int_distribution<>(0, 1);
+    auto interaction = graph::Square<double>(6, 6);
+    for(std::size_t r=0; r<6; r++){
+        for(std::size_t c=0; c<6; c++){
+            interaction.J(r, c, graph::Dir::PLUS_R) = 2*uid(engine_for_interaction)-1;
+            interaction.J(r, c, graph::Dir::PLUS_C) = 2*uid(engine_for_interaction)-1;
+            interaction.h(r, c) = 0.1*(2*uid(engine_for_interaction)-1);
+        }
+    }
+
+    auto engine_for_spin = std::mt19937(1);
+    auto replica_a = system::make_classical_ising(interaction.gen_spin(engine_for_spin), static_cast<graph::Sparse<double>>(interaction));
+    auto replica_b = system::make_classical_ising(interaction.gen_spin(engine_for_spin), static_cast<graph::Sparse<double>>(interaction));
+
+    auto random_number_engine = std::mt19937(1);
+    using Updater = updater::Houdayer<system::ClassicalIsing<graph::Sparse<double>>>;
+    for(std::size_t i=0; i<10; i++){
+        const auto spins_a = result::get_solution(replica_a);
+        const auto spins_b = result::get_solution(replica_b);
+        const auto energy = interaction.calc_energy(spins_a) + interaction.calc_energy(spins_b);
+
+        const auto cluster_size = Updater::cluster_move(replica_a, replica_b, random_number_engine);
+        EXPECT_GT(cluster_size, 0);
+        EXPECT_NE(spins_a, result::get_solution(replica_a));
+        EXPECT_NEAR(energy, interaction.calc_energy(result::get_solution(replica_a)) + interaction.calc_energy(result::get_solution(replica_b)), 1e-10);
+        EXPECT_NEAR(interaction.calc_energy(result::get_solution(replica_a)), replica_a.observables.energy, 1e-10);
+        EXPECT_NEAR(interaction.calc_energy(result::get_solution(replica_b)), replica_b.observables.energy, 1e-10);
+
+        //decorrelate the replicas before the next move
+        updater::SingleSpinFlip<system::ClassicalIsing<graph::Sparse<double>>>::update(replica_a, random_number_engine, utility::ClassicalUpdaterParameter(0.1));
+    }
+}
+
 
 /* Continuous time Swendsen-Wang test */
 TEST(ContinuousTimeSwendsenWang, Place_Cuts) {
@@ -473,6 +1467,80 @@ TEST(ContinuousTimeSwendsenWang, Place_Cuts_Special_Case) {
     EXPECT_EQ(timeline, correct_timeline);
 }
 
+TEST(ContinuousTimeSwendsenWang, AdvanceCursorAgreesWithBinarySearch) {
+    using namespace openjij;
+    using CTIsing = system::ContinuousTimeIsing<graph::Sparse<double>>;
+    using TimeType = typename CTIsing::TimeType;
+    using CutPoint = typename CTIsing::CutPoint;
+
+    std::vector<CutPoint> timeline;
+    for(int k = 0;k < 40;k++) {
+        timeline.emplace_back(0.25*k + 0.1, (k%2 == 0) ? 1 : -1);
+    }
+    auto system = CTIsing(CTIsing::SpinConfiguration{ timeline }, graph::Sparse<double>(1), 1.0);
+
+    std::vector<TimeType> bonds { 0.0, 0.05, 0.1, 0.1, 0.2, 1.3, 1.35, 5.0, 9.8, 9.9, 10.0 };
+    std::size_t cursor = 0;
+    for(auto bond : bonds) {
+        cursor = updater::ContinuousTimeSwendsenWang<CTIsing>::advance_cursor(timeline, cursor, bond);
+        auto k = (cursor == 0) ? timeline.size()-1 : cursor-1;
+        EXPECT_EQ(k, system.get_temporal_spin_index(0, bond));
+    }
+}
+
+TEST(ContinuousTimeIsing, CompactSpinConfigurationKeepsTimelines) {
+    using namespace openjij;
+    using CTIsing = system::ContinuousTimeIsing<graph::Sparse<double>>;
+
+    auto engine = std::mt19937(1);
+    auto urd = std::uniform_real_distribution<>(0.0, 1.0);
+    CTIsing::SpinConfiguration spin_config;
+    for(std::size_t i = 0;i < 10;i++) {
+        std::vector<double> times(1 + 13*i);
+        for(auto& t : times) t = urd(engine);
+        std::sort(times.begin(), times.end());
+
+        std::vector<CTIsing::CutPoint> timeline;
+        for(auto t : times) timeline.emplace_back(t, (urd(engine) < 0.5) ? 1 : -1);
+        spin_config.push_back(timeline);
+    }
+    auto system = CTIsing(spin_config, graph::Sparse<double>(10), 1.0);
+
+    //the auxiliary timeline is added
+    auto expected = spin_config;
+    expected.push_back({CTIsing::CutPoint(0.0, 1)});
+    EXPECT_EQ(expected, system.get_spin_config());
+    EXPECT_EQ(11, system.spin_config.num_sites());
+
+    //binary search on the contiguous time points
+    for(std::size_t i = 0;i < 10;i++) {
+        for(auto t : {0.0, 0.3, 0.5, 0.99}) {
+            const auto& timeline = spin_config[i];
+            std::size_t k = timeline.size()-1; //periodic boundary condition
+            for(std::size_t l = 0;l < timeline.size();l++) {
+                if(!(t < timeline[l].first)) k = l;
+            }
+            EXPECT_EQ(k, system.get_temporal_spin_index(i, t));
+        }
+    }
+
+    //concatenation of blocks which do not end at a word boundary
+    CTIsing::CompactConfiguration concatenated;
+    for(std::size_t first = 0;first < 11;first += 3) {
+        CTIsing::CompactConfiguration block;
+        for(std::size_t i = first;i < std::min<std::size_t>(first+3, 11);i++) {
+            block.push_back(expected[i]);
+        }
+        concatenated.append(block);
+    }
+    EXPECT_EQ(system.spin_config, concatenated);
+
+    system.spin_config.flip(3, 5);
+    expected[3][5].second *= -1;
+    EXPECT_EQ(expected, system.get_spin_config());
+    EXPECT_NE(system.spin_config, concatenated);
+}
+
 TEST(ContinuousTimeSwendsenWang, FindTrueGroundState_ContinuousTimeIsing_Sparse_OneDimensionalIsing) {
     using namespace openjij;
 
@@ -520,6 +1588,98 @@ TEST(ContinuousTimeSwendsenWang, FindTrueGroundState_ContinuousTimeIsing_Sparse)
     EXPECT_EQ(get_true_groundstate(), result::get_solution(ising));
 }
 
+TEST(ParallelContinuousTimeSwendsenWang, FindTrueGroundState_ContinuousTimeIsing_Sparse) {
+    using namespace openjij;
+
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+
+    const auto spins = interaction.gen_spin(engine_for_spin);
+
+    auto ising = system::make_continuous_time_ising(spins, interaction, 1.0);
+
+    auto random_numder_engine = std::mt19937(1);
+    const auto schedule_list = utility::make_transverse_field_schedule_list(10, 100, 3000);
+
+    algorithm::Algorithm<updater::ParallelContinuousTimeSwendsenWang>::run(ising, random_numder_engine, schedule_list);
+
+    EXPECT_EQ(get_true_groundstate(), result::get_solution(ising));
+}
+
+TEST(ParallelContinuousTimeSwendsenWang, ResultIsIndependentOfNumberOfThreads) {
+    using namespace openjij;
+    constexpr std::size_t L = 10;
+
+    //two-dimensional lattice with random couplings, so that the timelines cross the words of the packed spins
+    auto interaction = graph::Sparse<double>(L*L);
+    auto engine_for_interaction = std::mt19937(1);
+    auto urd = std::uniform_real_distribution<>(-1.0, 1.0);
+    for(std::size_t x=0; x<L; x++){
+        for(std::size_t y=0; y<L; y++){
+            const std::size_t i = x*L + y;
+            interaction.h(i) = urd(engine_for_interaction);
+            for(const std::size_t j : {((x+1)%L)*L + y, x*L + (y+1)%L}){
+                interaction.J(i, j) = urd(engine_for_interaction);
+            }
+        }
+    }
+    auto engine_for_spin = std::mt19937(1);
+    const auto spins = interaction.gen_spin(engine_for_spin);
+    //strong transverse field keeps many cuts on each timeline
+    auto schedule_list = utility::TransverseFieldScheduleList(5);
+    for(auto& schedule : schedule_list){
+        schedule.one_mc_step = 5;
+        schedule.updater_parameter = utility::TransverseFieldUpdaterParameter(5.0, 0.2);
+    }
+
+    auto run = [&](std::size_t num_threads){
+        auto ising = system::make_continuous_time_ising(spins, interaction, 1.0);
+        auto random_number_engine = std::mt19937(1);
+#ifdef _OPENMP
+        const int max_threads = omp_get_max_threads();
+        omp_set_num_threads(static_cast<int>(num_threads));
+#else
+        (void)num_threads;
+#endif
+        algorithm::Algorithm<updater::ParallelContinuousTimeSwendsenWang>::run(ising, random_number_engine, schedule_list);
+#ifdef _OPENMP
+        omp_set_num_threads(max_threads);
+#endif
+        return ising.get_spin_config();
+    };
+
+    const auto spin_config = run(1);
+    //there are timelines with many cuts
+    EXPECT_LT(L*L + 64, std::accumulate(spin_config.begin(), spin_config.end(), std::size_t(0),
+                [](std::size_t sum, const auto& timeline){ return sum + timeline.size(); }));
+    EXPECT_EQ(spin_config, run(3));
+    EXPECT_EQ(spin_config, run(4));
+}
+
+TEST(PackedTransverseIsing, PackedSpinsAndKinks) {
+    using namespace openjij;
+
+    const std::size_t num_trotter_slices = 70; //two words per site
+    auto engine = std::mt19937(1);
+    auto interaction = graph::Sparse<double>(3);
+
+    system::TrotterSpins trotter_spins(num_trotter_slices);
+    for(auto& spins : trotter_spins){
+        spins = interaction.gen_spin(engine);
+    }
+
+    auto system = system::make_packed_transverse_ising(trotter_spins, interaction, 1.0);
+    EXPECT_EQ(system.get_trotter_spins(), trotter_spins);
+
+    for(std::size_t i = 0; i < 3; i++){
+        std::size_t kinks = 0;
+        for(std::size_t t = 0; t < num_trotter_slices; t++){
+            kinks += (trotter_spins[t][i] != trotter_spins[(t+1)%num_trotter_slices][i]);
+        }
+        EXPECT_EQ(system.num_kinks(i), kinks);
+    }
+}
+
 TEST(RESULT, GetSolutionFromTrotter){
     auto graph = openjij::graph::Dense<float>(4);
     graph.J(1, 1) = -1.0;
@@ -758,6 +1918,92 @@ TEST(Eigen, CopyFromGraphToEigenMatrix) {
     EXPECT_EQ(mat_s.coeff(N,N), 1);
 }
 
+TEST(Random, Philox4x32KnownAnswer) {
+    using namespace openjij;
+    using Philox = utility::Philox4x32;
+
+    //test vectors of Random123
+    EXPECT_EQ((Philox::counter_type{{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}}),
+              Philox::block({{0u, 0u, 0u, 0u}}, {{0u, 0u}}));
+    EXPECT_EQ((Philox::counter_type{{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}}),
+              Philox::block({{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}}, {{0xffffffffu, 0xffffffffu}}));
+    EXPECT_EQ((Philox::counter_type{{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}}),
+              Philox::block({{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}}, {{0xa4093822u, 0x299f31d0u}}));
+
+    //discard skips the same numbers as calling the engine
+    for(unsigned long long skip : {0ull, 1ull, 3ull, 4ull, 9ull}){
+        auto engine = Philox(1, 2);
+        auto skipped = Philox(1, 2);
+        engine();
+        skipped();
+        for(unsigned long long i=0; i<skip; i++){
+            engine();
+        }
+        skipped.discard(skip);
+        EXPECT_EQ(engine, skipped);
+        EXPECT_EQ(engine(), skipped());
+    }
+
+    //the state is restored from text in the middle of a block
+    auto engine = Philox(1, 2);
+    engine();
+    std::stringstream ss;
+    ss << engine;
+    auto restored = Philox(0);
+    ss >> restored;
+    EXPECT_EQ(engine, restored);
+    EXPECT_EQ(engine(), restored());
+
+    //streams are different
+    EXPECT_NE(Philox(1, 0)(), Philox(1, 1)());
+}
+
+TEST(Random, Xoshiro256StarStarJump) {
+    using namespace openjij;
+    using Xoshiro = utility::Xoshiro256StarStar;
+    using State = std::array<Xoshiro::result_type, 4>;
+
+    //reference outputs from the state {1, 2, 3, 4}
+    auto engine = Xoshiro(State{{1, 2, 3, 4}});
+    EXPECT_EQ(11520ull, engine());
+    EXPECT_EQ(0ull, engine());
+    EXPECT_EQ(1509978240ull, engine());
+    EXPECT_EQ(1215971899390074240ull, engine());
+
+    auto jumped = Xoshiro(State{{1, 2, 3, 4}});
+    jumped.jump();
+    EXPECT_EQ(Xoshiro(State{{10122426448480695249ull, 8079205330032121950ull, 7289065458748526725ull, 9477464255293849680ull}}), jumped);
+
+    auto long_jumped = Xoshiro(State{{1, 2, 3, 4}});
+    long_jumped.long_jump();
+    EXPECT_NE(jumped, long_jumped);
+
+    //substream i is the master engine advanced by i jumps
+    const auto master = Xoshiro(1);
+    const auto substreams = utility::make_substreams(master, 3);
+    ASSERT_EQ(3, substreams.size());
+    auto expected = master;
+    for(const auto& substream : substreams){
+        EXPECT_EQ(expected, substream);
+        expected.jump();
+    }
+    EXPECT_TRUE(utility::has_jump<Xoshiro>::value);
+    EXPECT_FALSE(utility::has_jump<utility::Xorshift>::value);
+
+    //replicas with the substreams do not depend on the number of threads
+    const auto interaction = generate_interaction<graph::Sparse<double>>();
+    auto engine_for_spin = std::mt19937(1);
+    const auto spin = interaction.gen_spin(engine_for_spin);
+    const auto schedule_list = utility::make_classical_schedule_list(0.1, 10.0, 10, 20);
+    std::vector<system::ClassicalIsing<graph::Sparse<double>>> replicas(3, system::make_classical_ising(spin, interaction));
+    algorithm::Algorithm<updater::SingleSpinFlip>::run_replicas(replicas, master, schedule_list);
+
+    auto classical_ising = system::make_classical_ising(spin, interaction);
+    auto random_number_engine = substreams[2];
+    algorithm::Algorithm<updater::SingleSpinFlip>::run(classical_ising, random_number_engine, schedule_list);
+    EXPECT_EQ(result::get_solution(replicas[2]), result::get_solution(classical_ising));
+}
+
 TEST(UnionFind, UniteSevenNodesToMakeThreeSets) {
     auto union_find = openjij::utility::UnionFind(7);
 
@@ -794,6 +2040,34 @@ TEST(UnionFind, ConnectingEachNodeAndAllAdjacentNodesResultsInOneSet) {
     }
 }
 
+TEST(UnionFind, ResetMakesEachNodeIsInEachClusterAgain) {
+    auto union_find = openjij::utility::UnionFind(7);
+
+    for (std::size_t node = 0; node < 6; ++node) {
+        union_find.unite_sets(node, node+1);
+    }
+    union_find.reset(5);
+
+    auto expect = std::vector<decltype(union_find)::Node>{0,1,2,3,4};
+    for (std::size_t node = 0; node < 5; ++node) {
+        EXPECT_EQ(union_find.find_set(node), expect[node]);
+    }
+}
+
+TEST(ConcurrentUnionFind, RootIsSmallestNodeOfEachSet) {
+    auto union_find = openjij::utility::ConcurrentUnionFind(7);
+
+    union_find.unite_sets(0,1);
+    union_find.unite_sets(1,4);
+    union_find.unite_sets(6,5);
+    union_find.unite_sets(5,3);
+
+    auto expect = std::vector<decltype(union_find)::Node>{0,0,2,3,0,3,3};
+    for (std::size_t node = 0; node < 7; ++node) {
+        EXPECT_EQ(union_find.find_set(node), expect[node]);
+    }
+}
+
 #ifdef USE_CUDA
 
 TEST(GPUUtil, UniqueDevPtrTest){
@@ -112,9 +112,90 @@ class TestSamplers(unittest.TestCase):
         res = sampler.sample_ising(self.afih, self.afiJ)
         self.assertDictEqual(self.afiground, res.first.sample)
 
+    def test_sa_n_fold_way(self):
+        sampler = oj.SASampler(num_sweeps=50, num_reads=10)
+        res = sampler.sample_ising(self.afih, self.afiJ, updater='n fold way', seed=1)
+        self.assertDictEqual(self.afiground, res.first.sample)
+
+        # the default schedule of n fold way makes several sweeps at each beta
+        model = oj.BinaryQuadraticModel(self.afih, self.afiJ, 'SPIN')
+        schedule, _ = oj.sampler.sa_sampler.geometric_ising_beta_schedule(model, num_sweeps=1000, num_sweeps_per_beta=10)
+        self.assertEqual(len(schedule), 100)
+        self.assertTrue(all(s.one_mc_step == 10 for s in schedule))
+
+    def test_sa_postprocess(self):
+        # without annealing (beta = 0), each returned state is polished to a 1-flip local minimum
+        sampler = oj.SASampler()
+        model = oj.BinaryQuadraticModel(self.afih, self.afiJ, 'SPIN')
+        res = sampler.sample_ising(self.afih, self.afiJ, schedule=[[0, 1]],
+                                   num_reads=10, seed=1, postprocess='steepest descent')
+        for sample, energy in zip(res.samples(), res.record.energy):
+            for i in sample:
+                flipped = dict(sample)
+                flipped[i] *= -1
+                self.assertLessEqual(energy, model.energy(flipped))
+        self.assertEqual(res.info['postprocess'], 'steepest descent')
+
+        with self.assertRaises(ValueError):
+            sampler.sample_ising(self.afih, self.afiJ, postprocess='gradient')
+
+    def test_float32(self):
+        for sampler in (oj.SASampler(), oj.SQASampler()):
+            res = sampler.sample_ising(
+                self.num_ind['h'], self.num_ind['J'], seed=1, precision='float32')
+            self._test_response(res, self.e_g, self.ground_state)
+            res = sampler.sample_qubo(self.qubo, seed=2, precision='float32')
+            self._test_response(res, self.e_q, self.ground_q)
+
+        sampler = oj.SASampler(num_sweeps=51, num_reads=10)
+        res = sampler.sample_ising(self.afih, self.afiJ, precision='float32')
+        self.assertDictEqual(self.afiground, res.first.sample)
+        res = sampler.sample_ising(self.afih, self.afiJ, updater='n fold way', precision='float32')
+        self.assertDictEqual(self.afiground, res.first.sample)
+
+        with self.assertRaises(ValueError):
+            sampler.sample_ising(self.afih, self.afiJ, precision='float16')
+
+    def test_random_engine(self):
+        engines = ('xorshift', 'mt19937', 'mt19937_64', 'philox4x32', 'xoshiro256**')
+        for engine in engines:
+            for sampler in (oj.SASampler(num_reads=5), oj.SQASampler(num_reads=5)):
+                res = sampler.sample_ising(
+                    self.num_ind['h'], self.num_ind['J'], seed=3, random_engine=engine)
+                self.assertListEqual(self.ground_state, [res.first.sample[i] for i in range(len(self.ground_state))])
+                # the same seed gives the same samples
+                res_again = sampler.sample_ising(
+                    self.num_ind['h'], self.num_ind['J'], seed=3, random_engine=engine)
+                np.testing.assert_array_equal(res.record.sample, res_again.record.sample)
+
+        # the reads use independent streams (philox4x32) or substreams (xoshiro256**)
+        for engine in ('philox4x32', 'xoshiro256**'):
+            sampler = oj.SASampler(num_reads=10)
+            res = sampler.sample_ising(self.afih, self.afiJ, schedule=[[0.0, 10]],
+                                       seed=3, random_engine=engine)
+            self.assertGreater(len(set(tuple(s) for s in res.record.sample)), 1)
+            res_again = sampler.sample_ising(self.afih, self.afiJ, schedule=[[0.0, 10]],
+                                             seed=3, random_engine=engine)
+            np.testing.assert_array_equal(res.record.sample, res_again.record.sample)
+
+        # schedule generators are accepted with an engine
+        sampler = oj.SASampler(num_reads=10)
+        generator = cj.utility.ClassicalGeometricSchedule(cj.utility.GeometricCurve(0.1, 10.0, 50), 10)
+        res = sampler.sample_ising(self.afih, self.afiJ, schedule=generator,
+                                   seed=1, random_engine='xoshiro256**')
+        self.assertDictEqual(self.afiground, res.first.sample)
+        sampler = oj.SQASampler()
+        generator = cj.utility.TransverseFieldLinearSchedule(5.0, cj.utility.LinearCurve(0.01, 1.0, 50), 10)
+        res = sampler.sample_ising(self.num_ind['h'], self.num_ind['J'], schedule=generator,
+                                   seed=1, random_engine='philox4x32')
+        self._test_response(res, self.e_g, self.ground_state)
+
+        with self.assertRaises(ValueError):
+            oj.SASampler().sample_ising(self.afih, self.afiJ, random_engine='ranlux')
+
     def test_sqa(self):
         sampler = oj.SQASampler()
-        
+
         self.samplers(sampler)
         self.samplers(sampler, 
             init_state=[1 for _ in range(len(self.ground_state))],
@@ -169,6 +250,22 @@ class TestSamplers(unittest.TestCase):
         res = sampler.sample_ising(self.afih, self.afiJ)
         self.assertDictEqual(self.afiground, res.first.sample)
 
+    def test_tabu(self):
+        sampler = oj.TabuSampler(num_iterations=100)
+        for sparse in (False, True):
+            res = sampler.sample_ising(
+                self.num_ind['h'], self.num_ind['J'], seed=1, sparse=sparse)
+            self._test_response(res, self.e_g, self.ground_state)
+            res = sampler.sample_qubo(self.qubo, seed=2, sparse=sparse)
+            self._test_response(res, self.e_q, self.ground_q)
+
+        self._test_num_reads(oj.TabuSampler)
+
+        #antiferromagnetic one-dimensional Ising model
+        sampler = oj.TabuSampler(num_reads=10)
+        res = sampler.sample_ising(self.afih, self.afiJ)
+        self.assertDictEqual(self.afiground, res.first.sample)
+
 
 if __name__ == '__main__':
     unittest.main()